@@ -0,0 +1,183 @@
+/*
+ * Host tests of the effect clock synchronisation filter (wled00/clock_sync.h)
+ * Master and follower clocks are simulated in us, network delays are synthetic.
+ */
+
+#include <unity.h>
+#include "test_helpers.h"
+#include "clock_sync.h"
+
+#define SYNC_INTERVAL 1000000 // us between exchanges
+#define LOOP_INTERVAL   20000 // us between takeCorrection() calls
+#define TURNAROUND        300 // us master needs to reply
+
+static ClockSync cs;
+static int64_t  now;          // true time in us
+static int64_t  masterBase;   // master clock = now + masterBase (+ drift)
+static int64_t  followerBase; // follower clock = now + followerBase, corrected by the filter
+static int32_t  driftPpm;
+static int32_t  maxStep;      // largest single correction in ms after the first
+
+static uint32_t masterClock(int64_t t)   { return (uint32_t)(t + masterBase + t * driftPpm / 1000000); }
+static uint32_t followerClock(int64_t t) { return (uint32_t)(t + followerBase); }
+static int32_t  clockError()             { return (int32_t)(masterClock(now) - followerClock(now)); }
+
+typedef uint32_t (*DelayFn)(bool toMaster);
+
+static uint32_t symmetric(bool)          { return 2000; }
+static uint32_t asymmetric(bool toMaster) { return toMaster ? 1000 : 9000; }
+// WiFi like: mostly a few ms, random queuing, sometimes a retransmission burst
+static uint32_t jittered(bool)
+{
+  uint32_t d = 1500 + rnd(3000);
+  if (rnd(4) == 0) d += rnd(20000);
+  if (rnd(20) == 0) d += 60000;
+  return d;
+}
+
+// one request/reply exchange, returns result of addSample()
+static bool exchange(DelayFn delay)
+{
+  uint32_t d1 = delay(true), d2 = delay(false);
+  uint32_t t1 = followerClock(now);
+  uint32_t t2 = masterClock(now + d1);
+  uint32_t t3 = t2 + TURNAROUND;
+  uint32_t t4 = followerClock(now + d1 + TURNAROUND + d2);
+  return cs.addSample(t1, t2, t3, t4);
+}
+
+// runs for the given time, exchanging every SYNC_INTERVAL and applying corrections as the main loop does
+static void run(uint32_t seconds, DelayFn delay)
+{
+  int64_t end = now + (int64_t)seconds * 1000000;
+  for (; now < end; now += LOOP_INTERVAL) {
+    if (now % SYNC_INTERVAL == 0) exchange(delay);
+    int32_t ms = cs.takeCorrection((uint32_t)(now / 1000));
+    followerBase += (int64_t)ms * 1000;
+    if (ms < 0) ms = -ms;
+    if (ms > maxStep) maxStep = ms;
+  }
+}
+
+void setUp(void)
+{
+  cs.reset();
+  rngSeed(1);
+  now = 0;
+  masterBase = 0;
+  followerBase = 0;
+  driftPpm = 0;
+  maxStep = 0;
+}
+
+void tearDown(void) {}
+
+// large initial offset is stepped at once
+void test_initial_step(void)
+{
+  masterBase = 3456789;
+  TEST_ASSERT_FALSE(cs.isLocked());
+  TEST_ASSERT_TRUE(exchange(symmetric));
+  TEST_ASSERT_TRUE(cs.isLocked());
+  followerBase += (int64_t)cs.takeCorrection(0) * 1000;
+  TEST_ASSERT_INT_WITHIN(500, 0, clockError());
+}
+
+// offset below the step limit is slewed in 1 ms steps without visible jumps
+void test_slew(void)
+{
+  run(3, symmetric);
+  masterBase += 20000; // master timebase changed by 20 ms
+  maxStep = 0;
+  run(2, symmetric);
+  TEST_ASSERT_TRUE(clockError() > 5000);  // not there yet: 0.5% slew rate
+  run(6, symmetric);
+  TEST_ASSERT_INT_WITHIN(1000, 0, clockError());
+  TEST_ASSERT_EQUAL_INT32(1, maxStep);
+}
+
+// beyond the step limit the follower jumps again
+void test_restep(void)
+{
+  run(3, symmetric);
+  masterBase -= 500000;
+  run(2, symmetric);
+  TEST_ASSERT_INT_WITHIN(1000, 0, clockError());
+}
+
+// different delay each way: offset is off by half the difference, but stable
+void test_asymmetric_delay(void)
+{
+  masterBase = -123456;
+  run(30, asymmetric);
+  TEST_ASSERT_INT_WITHIN(1000, (9000 - 1000) / 2, clockError());
+  TEST_ASSERT_EQUAL_UINT32(1000 + 9000, cs.getDelay());
+  maxStep = 0;
+  run(30, asymmetric);
+  TEST_ASSERT_LESS_OR_EQUAL(1, maxStep);
+}
+
+// random queuing delays: least delayed samples win, offset converges close to the truth
+void test_jittered_delay(void)
+{
+  masterBase = 7777777;
+  run(20, jittered);
+  maxStep = 0;
+  int32_t worst = 0;
+  for (uint8_t i = 0; i < 60; i++) {
+    run(1, jittered);
+    int32_t e = clockError();
+    if (e < 0) e = -e;
+    if (e > worst) worst = e;
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(1500, worst);
+  TEST_ASSERT_LESS_OR_EQUAL(1, maxStep);   // no jumps once locked
+  TEST_ASSERT_LESS_OR_EQUAL(8000, cs.getDelay()); // one of the quick exchanges
+  TEST_ASSERT_GREATER_THAN(0, cs.getJitter());
+}
+
+// master crystal runs fast: follower keeps up by slewing
+void test_drift(void)
+{
+  driftPpm = 200;
+  run(5, symmetric);
+  maxStep = 0;
+  run(60, jittered);
+  TEST_ASSERT_INT_WITHIN(1500, 0, clockError());
+  TEST_ASSERT_LESS_OR_EQUAL(1, maxStep);
+}
+
+// clocks wrap at 32 bit us (about 71 minutes)
+void test_wrap(void)
+{
+  masterBase = 0xFFFFFFFFLL - 2500000;    // master wraps after 2.5 s
+  followerBase = 0xFFFFFFFFLL - 4000000;
+  run(10, symmetric);
+  TEST_ASSERT_INT_WITHIN(1000, 0, clockError());
+  TEST_ASSERT_LESS_OR_EQUAL(CLOCK_SYNC_MAX_DELAY, cs.getDelay());
+}
+
+// useless replies are discarded
+void test_discard(void)
+{
+  TEST_ASSERT_FALSE(cs.addSample(1000, 5000, 5100, 1000 + CLOCK_SYNC_MAX_DELAY + 500)); // round trip too long
+  TEST_ASSERT_FALSE(cs.addSample(1000, 5000, 5100, 900));                               // reply before request
+  TEST_ASSERT_FALSE(cs.isLocked());
+  TEST_ASSERT_TRUE(cs.addSample(1000, 5000, 5100, 3000));
+  TEST_ASSERT_EQUAL_INT32(3050, cs.getOffset());
+  TEST_ASSERT_EQUAL_UINT32(1900, cs.getDelay());
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_initial_step);
+  RUN_TEST(test_slew);
+  RUN_TEST(test_restep);
+  RUN_TEST(test_asymmetric_delay);
+  RUN_TEST(test_jittered_delay);
+  RUN_TEST(test_drift);
+  RUN_TEST(test_wrap);
+  RUN_TEST(test_discard);
+  return UNITY_END();
+}
@@ -0,0 +1,219 @@
+/*
+ * Host tests of multi-source E1.31 / Art-Net merging (wled00/e131_merge.h)
+ */
+
+#include <unity.h>
+#include "e131_merge.h"
+
+static E131Merge m;
+static const uint8_t cidA[E131_CID_LEN] = {0xA0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15};
+static const uint8_t cidB[E131_CID_LEN] = {0xB0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15};
+static const uint8_t cidC[E131_CID_LEN] = {0xC0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15};
+static uint8_t dataA[E131_MERGE_DATA_LEN];
+static uint8_t dataB[E131_MERGE_DATA_LEN];
+static uint8_t dataC[E131_MERGE_DATA_LEN];
+
+// packet without sequence check
+static uint8_t* packet(const uint8_t *cid, uint8_t priority, uint8_t *data, uint16_t &len, uint32_t now, uint8_t uni = 0)
+{
+  return m.merge(uni, cid, priority, 0, false, data, len, now);
+}
+
+void setUp(void)
+{
+  m.setMode(E131_MERGE_LTP);
+  m.setTimeout(2500);
+  memset(dataA, 0, sizeof(dataA));
+  memset(dataB, 0, sizeof(dataB));
+  memset(dataC, 0, sizeof(dataC));
+}
+
+void tearDown(void)
+{
+  m.reset();
+}
+
+void test_single_source(void)
+{
+  uint16_t len = 100;
+  TEST_ASSERT_TRUE(packet(cidA, 100, dataA, len, 1000) == dataA);
+  TEST_ASSERT_EQUAL_UINT16(100, len);
+  TEST_ASSERT_EQUAL_UINT8(1, m.getSourceCount(0));
+  TEST_ASSERT_EQUAL_UINT8(0, m.getSourceCount(1));
+  // universes beyond the table are passed through
+  TEST_ASSERT_TRUE(packet(cidB, 1, dataB, len, 1000, E131_MERGE_UNIVERSES) == dataB);
+}
+
+// equal priority in LTP mode: latest packet wins
+void test_ltp(void)
+{
+  uint16_t len = 10;
+  TEST_ASSERT_TRUE(packet(cidA, 100, dataA, len, 1000) == dataA);
+  TEST_ASSERT_TRUE(packet(cidB, 100, dataB, len, 1010) == dataB);
+  TEST_ASSERT_TRUE(packet(cidA, 100, dataA, len, 1020) == dataA);
+  TEST_ASSERT_EQUAL_UINT8(2, m.getSourceCount(0));
+}
+
+// equal priority in HTP mode: highest value of each channel, last data of each source is kept
+void test_htp(void)
+{
+  m.setMode(E131_MERGE_HTP);
+  dataA[1] = 200; dataA[2] = 10;
+  dataB[1] = 50;  dataB[2] = 60; dataB[5] = 7;
+  uint16_t len = 4;
+  TEST_ASSERT_TRUE(packet(cidA, 100, dataA, len, 1000) == dataA); // only source so far
+  len = 6;
+  uint8_t *out = packet(cidB, 100, dataB, len, 1010);
+  TEST_ASSERT_NOT_NULL(out);
+  TEST_ASSERT_EQUAL_UINT16(6, len);                               // longest source
+  TEST_ASSERT_EQUAL_UINT8(200, out[1]);
+  TEST_ASSERT_EQUAL_UINT8(60, out[2]);
+  TEST_ASSERT_EQUAL_UINT8(7, out[5]);
+
+  dataA[1] = 0; // A fades out channel 1
+  len = 4;
+  out = packet(cidA, 100, dataA, len, 1020);
+  TEST_ASSERT_NOT_NULL(out);
+  TEST_ASSERT_EQUAL_UINT16(6, len);
+  TEST_ASSERT_EQUAL_UINT8(50, out[1]);
+  TEST_ASSERT_EQUAL_UINT8(60, out[2]);
+  // caller buffer is not modified
+  TEST_ASSERT_EQUAL_UINT8(0, dataA[1]);
+}
+
+// lower priority source in HTP mode does not contribute
+void test_htp_priority(void)
+{
+  m.setMode(E131_MERGE_HTP);
+  dataA[1] = 10; dataB[1] = 20; dataC[1] = 255;
+  uint16_t len = 2;
+  packet(cidA, 100, dataA, len, 1000);
+  packet(cidB, 100, dataB, len, 1000);
+  TEST_ASSERT_NULL(packet(cidC, 50, dataC, len, 1000));
+  uint8_t *out = packet(cidA, 100, dataA, len, 1010);
+  TEST_ASSERT_EQUAL_UINT8(20, out[1]);
+}
+
+// higher priority takes over, lower priority is used again once the higher one times out
+void test_priority_takeover_and_fallback(void)
+{
+  uint16_t len = 10;
+  TEST_ASSERT_TRUE(packet(cidA, 100, dataA, len, 1000) == dataA);
+  TEST_ASSERT_TRUE(packet(cidB, 150, dataB, len, 1010) == dataB);  // backup console with higher priority
+  TEST_ASSERT_NULL(packet(cidA, 100, dataA, len, 1020));            // main is ignored meanwhile
+  TEST_ASSERT_TRUE(packet(cidB, 150, dataB, len, 2000) == dataB);
+  TEST_ASSERT_NULL(packet(cidA, 100, dataA, len, 4000));            // B heard 2 s ago, still valid
+  TEST_ASSERT_TRUE(packet(cidA, 100, dataA, len, 4501) == dataA);   // B silent for longer than the timeout
+  TEST_ASSERT_EQUAL_UINT8(1, m.getSourceCount(0));
+  TEST_ASSERT_TRUE(packet(cidB, 150, dataB, len, 4600) == dataB);  // B back, takes over again
+  TEST_ASSERT_NULL(packet(cidA, 100, dataA, len, 4610));
+}
+
+// priority change of a known source applies immediately
+void test_priority_change(void)
+{
+  uint16_t len = 10;
+  packet(cidA, 100, dataA, len, 1000);
+  packet(cidB, 150, dataB, len, 1000);
+  TEST_ASSERT_TRUE(packet(cidB, 50, dataB, len, 1010) == nullptr);
+  TEST_ASSERT_TRUE(packet(cidA, 100, dataA, len, 1020) == dataA);
+}
+
+void test_timeout_setting(void)
+{
+  m.setTimeout(500);
+  uint16_t len = 10;
+  packet(cidB, 150, dataB, len, 1000);
+  TEST_ASSERT_NULL(packet(cidA, 100, dataA, len, 1400));
+  TEST_ASSERT_TRUE(packet(cidA, 100, dataA, len, 1600) == dataA);
+}
+
+// stream terminated: the source is dropped at once, without waiting for the timeout
+void test_termination(void)
+{
+  uint16_t len = 10;
+  packet(cidA, 100, dataA, len, 1000);
+  packet(cidB, 150, dataB, len, 1000);
+  TEST_ASSERT_EQUAL_UINT8(2, m.getSourceCount(0));
+  m.terminate(0, cidB);
+  TEST_ASSERT_EQUAL_UINT8(1, m.getSourceCount(0));
+  TEST_ASSERT_TRUE(packet(cidA, 100, dataA, len, 1010) == dataA);
+  m.terminate(0, cidC);                    // unknown source
+  m.terminate(E131_MERGE_UNIVERSES, cidA); // out of range
+  TEST_ASSERT_EQUAL_UINT8(1, m.getSourceCount(0));
+}
+
+// termination of an HTP source removes its channels from the merge
+void test_htp_termination(void)
+{
+  m.setMode(E131_MERGE_HTP);
+  dataA[1] = 10; dataB[1] = 200;
+  uint16_t len = 2;
+  packet(cidA, 100, dataA, len, 1000);
+  packet(cidB, 100, dataB, len, 1000);
+  m.terminate(0, cidB);
+  TEST_ASSERT_TRUE(packet(cidA, 100, dataA, len, 1010) == dataA);
+}
+
+// late and duplicate packets are dropped (E1.31 6.7.2), sequence numbers wrap
+void test_sequence(void)
+{
+  uint16_t len = 10;
+  TEST_ASSERT_NOT_NULL(m.merge(0, cidA, 100, 250, true, dataA, len, 1000));
+  TEST_ASSERT_NULL(m.merge(0, cidA, 100, 250, true, dataA, len, 1001));     // duplicate
+  TEST_ASSERT_NULL(m.merge(0, cidA, 100, 245, true, dataA, len, 1002));     // late
+  TEST_ASSERT_NOT_NULL(m.merge(0, cidA, 100, 255, true, dataA, len, 1003));
+  TEST_ASSERT_NOT_NULL(m.merge(0, cidA, 100, 1, true, dataA, len, 1004));   // wrapped
+  TEST_ASSERT_NULL(m.merge(0, cidA, 100, 254, true, dataA, len, 1005));     // late across the wrap
+  TEST_ASSERT_NOT_NULL(m.merge(0, cidA, 100, 200, true, dataA, len, 1006)); // far behind: sender restarted
+  TEST_ASSERT_NOT_NULL(m.merge(0, cidA, 100, 0, true, dataA, len, 1007));   // 0 is not checked
+  TEST_ASSERT_NOT_NULL(m.merge(0, cidA, 100, 0, false, dataA, len, 1008));  // Art-Net without sequence
+  // sequence is tracked per source
+  TEST_ASSERT_NOT_NULL(m.merge(0, cidB, 100, 5, true, dataB, len, 1009));
+  TEST_ASSERT_NOT_NULL(m.merge(0, cidA, 100, 5, true, dataA, len, 1010));
+}
+
+// table full: new source only replaces one with lower priority
+void test_table_full(void)
+{
+  uint16_t len = 10;
+  uint8_t cid[E131_CID_LEN] = {0};
+  for (uint8_t i = 0; i < E131_MERGE_SOURCES; i++) {
+    cid[0] = i;
+    TEST_ASSERT_NOT_NULL(m.merge(0, cid, 100 + i, 0, false, dataA, len, 1000));
+  }
+  cid[0] = 0xEE;
+  TEST_ASSERT_NULL(m.merge(0, cid, 100, 0, false, dataA, len, 1010));
+  TEST_ASSERT_EQUAL_UINT8(E131_MERGE_SOURCES, m.getSourceCount(0));
+  TEST_ASSERT_NOT_NULL(m.merge(0, cid, 200, 0, false, dataA, len, 1020));
+  TEST_ASSERT_EQUAL_UINT8(E131_MERGE_SOURCES, m.getSourceCount(0));
+  cid[0] = 0; // lowest priority source was dropped, comes back as new source
+  TEST_ASSERT_NULL(m.merge(0, cid, 100, 0, false, dataA, len, 1030));
+}
+
+// universes are arbitrated independently
+void test_universes(void)
+{
+  uint16_t len = 10;
+  packet(cidB, 150, dataB, len, 1000, 0);
+  TEST_ASSERT_TRUE(packet(cidA, 100, dataA, len, 1000, 1) == dataA);
+  TEST_ASSERT_NULL(packet(cidA, 100, dataA, len, 1000, 0));
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_single_source);
+  RUN_TEST(test_ltp);
+  RUN_TEST(test_htp);
+  RUN_TEST(test_htp_priority);
+  RUN_TEST(test_priority_takeover_and_fallback);
+  RUN_TEST(test_priority_change);
+  RUN_TEST(test_timeout_setting);
+  RUN_TEST(test_termination);
+  RUN_TEST(test_htp_termination);
+  RUN_TEST(test_sequence);
+  RUN_TEST(test_table_full);
+  RUN_TEST(test_universes);
+  return UNITY_END();
+}
@@ -0,0 +1,19 @@
+#ifndef WLED_TEST_HELPERS_H
+#define WLED_TEST_HELPERS_H
+
+/*
+ * Helpers shared by the host tests
+ */
+
+#include <stdint.h>
+
+// deterministic pseudo random numbers 0 .. range-1, same sequence on every host
+static uint32_t rngState;
+static inline void rngSeed(uint32_t seed) { rngState = seed; }
+static inline uint32_t rnd(uint32_t range)
+{
+  rngState = rngState * 1103515245UL + 12345UL;
+  return (rngState >> 16) % range;
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * Host tests of the realtime jitter buffer (wled00/jitter_buffer.h)
+ * Packet timing traces are synthetic, time advances in 1 ms steps.
+ */
+
+#include <unity.h>
+#include "test_helpers.h"
+#include "jitter_buffer.h"
+
+#define TRACE_MAX 400
+
+static JitterBuffer jb;
+static uint32_t presented[TRACE_MAX]; // time each frame was presented
+static uint16_t presentedId[TRACE_MAX];
+static uint16_t presentedCount;
+static uint16_t slotId[WLED_MAX_JITTER_FRAMES];
+
+// arrival[i] is the local time frame i arrives, ts[i] its timecode (nullptr: no timecode)
+// runs until the last frame has been presented (an underrun would be counted if the trace went on)
+static void runTrace(const uint32_t *arrival, const uint32_t *ts, uint16_t frames)
+{
+  uint16_t next = 0;
+  presentedCount = 0;
+  for (uint32_t now = 1000; now < arrival[frames-1] + 1000 && (next < frames || jb.getCount()); now++) {
+    int8_t slot;
+    while ((slot = jb.pop(now)) >= 0) { // as in the main loop
+      TEST_ASSERT_TRUE(presentedCount < TRACE_MAX);
+      presentedId[presentedCount] = slotId[slot];
+      presented[presentedCount++] = now;
+    }
+    while (next < frames && arrival[next] == now) {
+      slot = jb.push(ts ? ts[next] : 0, ts != nullptr, now);
+      TEST_ASSERT_TRUE(slot >= 0 && slot < jb.getDepth());
+      slotId[slot] = next++;
+    }
+  }
+}
+
+// frames are presented in order, spacing after the first few frames within tolerance of the interval
+static void checkCadence(uint16_t skip, uint32_t interval, uint32_t tolerance)
+{
+  for (uint16_t i = 1; i < presentedCount; i++) {
+    TEST_ASSERT_TRUE(presentedId[i] > presentedId[i-1]);
+    if (i > skip) TEST_ASSERT_UINT32_WITHIN(tolerance, interval, presented[i] - presented[i-1]);
+  }
+}
+
+void setUp(void)
+{
+  rngSeed(1);
+  presentedCount = 0;
+}
+
+void tearDown(void) {}
+
+void test_disabled(void)
+{
+  jb.reset(0);
+  TEST_ASSERT_EQUAL_INT8(-1, jb.push(0, false, 1000));
+  TEST_ASSERT_EQUAL_INT8(-1, jb.pop(2000));
+  jb.reset(200);
+  TEST_ASSERT_EQUAL_UINT8(WLED_MAX_JITTER_FRAMES, jb.getDepth());
+}
+
+void test_timecode_to_ms(void)
+{
+  TEST_ASSERT_EQUAL_UINT32(0, JitterBuffer::timecodeToMs(0));
+  TEST_ASSERT_EQUAL_UINT32(1500, JitterBuffer::timecodeToMs(0x00018000));
+  TEST_ASSERT_EQUAL_UINT32(24, JitterBuffer::timecodeToMs(0x00000666)); // 0.02499 s, truncated
+  TEST_ASSERT_EQUAL_UINT32(65535999, JitterBuffer::timecodeToMs(0xFFFFFFFF));
+}
+
+// steady 40 FPS: every frame is presented once, no underruns or overruns
+void test_steady_cadence(void)
+{
+  uint32_t arrival[200];
+  for (uint16_t i = 0; i < 200; i++) arrival[i] = 1000 + i * 25;
+  jb.reset(2);
+  runTrace(arrival, nullptr, 200);
+  TEST_ASSERT_EQUAL_UINT16(200, presentedCount);
+  TEST_ASSERT_EQUAL_UINT16(25, jb.getInterval());
+  TEST_ASSERT_EQUAL_UINT32(0, jb.getUnderruns());
+  TEST_ASSERT_EQUAL_UINT32(0, jb.getOverruns());
+  checkCadence(2, 25, 1);
+  // playout delay is depth frames less half a frame
+  TEST_ASSERT_UINT32_WITHIN(2, 37, presented[199] - arrival[199]);
+}
+
+// arrivals delayed by 0-14 ms: presentation is smoothed to the source cadence
+void test_jittered_arrivals(void)
+{
+  uint32_t arrival[300];
+  for (uint16_t i = 0; i < 300; i++) arrival[i] = 1000 + i * 25 + rnd(15);
+  for (uint16_t i = 1; i < 300; i++) if (arrival[i] <= arrival[i-1]) arrival[i] = arrival[i-1] + 1;
+  jb.reset(3);
+  runTrace(arrival, nullptr, 300);
+  TEST_ASSERT_EQUAL_UINT16(300, presentedCount);
+  TEST_ASSERT_UINT32_WITHIN(1, 25, jb.getInterval());
+  TEST_ASSERT_EQUAL_UINT32(0, jb.getUnderruns());
+  TEST_ASSERT_EQUAL_UINT32(0, jb.getOverruns());
+  // spacing varies far less than the arrival jitter once the cadence is learned
+  checkCadence(20, 25, 6);
+}
+
+// frames bunched up by the network: buffer absorbs what fits, drops the oldest otherwise
+void test_burst_overrun(void)
+{
+  uint32_t arrival[60];
+  uint16_t n = 0;
+  for (; n < 20; n++) arrival[n] = 1000 + n * 25;
+  uint32_t t = arrival[n-1] + 100;            // 100 ms gap, then 5 frames at once
+  for (uint8_t b = 0; b < 5; b++) arrival[n++] = t;
+  for (uint8_t i = 1; n < 60; i++) arrival[n++] = t + i * 25;
+  jb.reset(2);
+  runTrace(arrival, nullptr, 60);
+  TEST_ASSERT_GREATER_THAN(0, jb.getOverruns());
+  TEST_ASSERT_EQUAL_UINT16(60 - jb.getOverruns(), presentedCount);
+  for (uint16_t i = 1; i < presentedCount; i++) TEST_ASSERT_TRUE(presentedId[i] > presentedId[i-1]);
+  TEST_ASSERT_EQUAL_UINT8(0, jb.getCount());
+}
+
+// sender pauses: one underrun, buffering starts over when frames come back
+void test_stall_underrun(void)
+{
+  uint32_t arrival[80];
+  for (uint16_t i = 0; i < 40; i++) arrival[i] = 1000 + i * 25;
+  for (uint16_t i = 40; i < 80; i++) arrival[i] = 1000 + i * 25 + 300;
+  jb.reset(2);
+  runTrace(arrival, nullptr, 80);
+  TEST_ASSERT_EQUAL_UINT32(1, jb.getUnderruns());
+  TEST_ASSERT_EQUAL_UINT32(0, jb.getOverruns());
+  TEST_ASSERT_EQUAL_UINT16(80, presentedCount);
+  // first frame after the pause is buffered again instead of being shown at once
+  TEST_ASSERT_TRUE(presented[40] > arrival[40]);
+}
+
+// with timecodes presentation follows the source clock exactly, regardless of arrival jitter
+void test_timecode_trace(void)
+{
+  uint32_t arrival[200], ts[200];
+  for (uint16_t i = 0; i < 200; i++) {
+    ts[i] = 50000 + i * 20;                   // 50 FPS source
+    arrival[i] = 1000 + i * 20 + rnd(12);
+  }
+  for (uint16_t i = 1; i < 200; i++) if (arrival[i] <= arrival[i-1]) arrival[i] = arrival[i-1] + 1;
+  jb.reset(2);
+  runTrace(arrival, ts, 200);
+  TEST_ASSERT_EQUAL_UINT16(200, presentedCount);
+  TEST_ASSERT_EQUAL_UINT16(20, jb.getInterval());
+  TEST_ASSERT_EQUAL_UINT32(0, jb.getUnderruns());
+  TEST_ASSERT_EQUAL_UINT32(0, jb.getOverruns());
+  checkCadence(2, 20, 0);
+}
+
+// source restarts its timecode: buffer re-anchors instead of waiting for the old timeline
+void test_timecode_restart(void)
+{
+  uint32_t arrival[100], ts[100];
+  for (uint16_t i = 0; i < 100; i++) {
+    arrival[i] = 1000 + i * 20;
+    ts[i] = i < 50 ? 90000 + i * 20 : (i - 50) * 20;
+  }
+  jb.reset(2);
+  runTrace(arrival, ts, 100);
+  // frames still buffered for the old timeline are discarded
+  TEST_ASSERT_TRUE(presentedCount >= 100 - jb.getDepth());
+  TEST_ASSERT_EQUAL_UINT16(99, presentedId[presentedCount-1]);
+  TEST_ASSERT_EQUAL_UINT32(0, jb.getOverruns());
+  for (uint16_t i = 1; i < presentedCount; i++) {
+    TEST_ASSERT_TRUE(presentedId[i] > presentedId[i-1]);
+    TEST_ASSERT_UINT32_WITHIN(50, 30, presented[i] - arrival[presentedId[i]]); // never waits for the old timeline
+  }
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_disabled);
+  RUN_TEST(test_timecode_to_ms);
+  RUN_TEST(test_steady_cadence);
+  RUN_TEST(test_jittered_arrivals);
+  RUN_TEST(test_burst_overrun);
+  RUN_TEST(test_stall_underrun);
+  RUN_TEST(test_timecode_trace);
+  RUN_TEST(test_timecode_restart);
+  return UNITY_END();
+}
@@ -0,0 +1,198 @@
+/*
+ * Host tests of WebSocket message reassembly (wled00/ws_reassembly.h)
+ * Fragment sequences are synthetic, as the async WebSocket server would hand them over.
+ */
+
+#include <unity.h>
+#include "ws_reassembly.h"
+
+#define OP_TEXT   1
+#define OP_BINARY 2
+#define OP_CONT   0
+#define LIMIT     64
+
+static WsReassembly ws;
+static uint8_t *msg;
+static size_t   msgLen;
+static uint8_t  msgOpcode;
+
+static uint8_t feed(uint32_t client, uint8_t opcode, uint32_t frameNum, bool final, uint64_t index, uint64_t frameLen, const char *data, size_t limit = LIMIT)
+{
+  return ws.feed(client, opcode, frameNum, final, index, frameLen, (const uint8_t*)data, strlen(data), limit, &msg, &msgLen, &msgOpcode);
+}
+
+// message text as received
+static void assertMessage(const char *expected, uint8_t opcode)
+{
+  TEST_ASSERT_EQUAL_UINT32(strlen(expected), msgLen);
+  TEST_ASSERT_EQUAL_MEMORY(expected, msg, msgLen);
+  TEST_ASSERT_EQUAL_UINT8(0, msg[msgLen]); // null terminated for the JSON parser
+  TEST_ASSERT_EQUAL_UINT8(opcode, msgOpcode);
+}
+
+void setUp(void)
+{
+  msg = nullptr;
+  msgLen = 0;
+  msgOpcode = 0xFF;
+}
+
+void tearDown(void)
+{
+  for (uint32_t c = 1; c <= 3; c++) ws.release(c);
+}
+
+void test_single_frame(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_TEXT, 0, true, 0, 5, "{\"a\"}"));
+  assertMessage("{\"a\"}", OP_TEXT);
+}
+
+// one frame delivered in several TCP chunks
+void test_chunked_frame(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING,  feed(1, OP_TEXT, 0, true, 0, 10, "abc"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING,  feed(1, OP_TEXT, 0, true, 3, 10, "defg"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_TEXT, 0, true, 7, 10, "hij"));
+  assertMessage("abcdefghij", OP_TEXT);
+}
+
+// message split into frames, each frame in chunks, opcode taken from the first frame
+void test_chunked_frames(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING,  feed(1, OP_BINARY, 0, false, 0, 4, "ab"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING,  feed(1, OP_BINARY, 0, false, 2, 4, "cd"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING,  feed(1, OP_CONT, 1, false, 0, 3, "efg"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING,  feed(1, OP_CONT, 2, true, 0, 2, "h"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_CONT, 2, true, 1, 2, "i"));
+  assertMessage("abcdefghi", OP_BINARY);
+  ws.release(1);
+  // slot is free for the next message
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_TEXT, 0, true, 0, 2, "ok"));
+  assertMessage("ok", OP_TEXT);
+}
+
+// last frame of a fragmented message carries no data
+void test_empty_final_frame(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING,  feed(1, OP_TEXT, 0, false, 0, 3, "abc"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_CONT, 1, true, 0, 0, ""));
+  assertMessage("abc", OP_TEXT);
+}
+
+void test_empty_message(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_TEXT, 0, true, 0, 0, ""));
+  TEST_ASSERT_NOT_NULL(msg);
+  assertMessage("", OP_TEXT);
+}
+
+// message beyond the limit is discarded up to its end, the next one is accepted again
+void test_over_limit(void)
+{
+  char big[41];
+  memset(big, 'x', 40);
+  big[40] = 0;
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING, feed(1, OP_TEXT, 0, false, 0, 40, big));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_ERROR,   feed(1, OP_CONT, 1, false, 0, 40, big)); // 80 > 64
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING, feed(1, OP_CONT, 2, false, 0, 3, "abc"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING, feed(1, OP_CONT, 3, true, 0, 3, "def"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_TEXT, 0, true, 0, 2, "ok"));
+  assertMessage("ok", OP_TEXT);
+}
+
+// exactly at the limit is fine
+void test_at_limit(void)
+{
+  char buf[LIMIT + 1];
+  memset(buf, 'y', LIMIT);
+  buf[LIMIT] = 0;
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_TEXT, 0, true, 0, LIMIT, buf));
+  TEST_ASSERT_EQUAL_UINT32(LIMIT, msgLen);
+}
+
+// two clients sending fragmented messages at the same time
+void test_interleaved_clients(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING,  feed(1, OP_TEXT, 0, false, 0, 3, "one"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING,  feed(2, OP_BINARY, 0, true, 0, 7, "tw"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING,  feed(1, OP_CONT, 1, false, 0, 1, "-"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(2, OP_CONT, 0, true, 2, 7, "o-two"));
+  assertMessage("two-two", OP_BINARY);
+  ws.release(2);
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_CONT, 2, true, 0, 3, "one"));
+  assertMessage("one-one", OP_TEXT);
+}
+
+// more clients than slots: the extra message is rejected, the others are not disturbed
+void test_no_free_slot(void)
+{
+  for (uint32_t c = 1; c <= WS_REASSEMBLY_SLOTS; c++) {
+    TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING, feed(c, OP_TEXT, 0, true, 0, 4, "ab"));
+  }
+  uint32_t extra = WS_REASSEMBLY_SLOTS + 1;
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_ERROR,   feed(extra, OP_TEXT, 0, true, 0, 4, "xy"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING, feed(extra, OP_TEXT, 0, true, 2, 4, "zz")); // ignored
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_TEXT, 0, true, 2, 4, "cd"));
+  assertMessage("abcd", OP_TEXT);
+}
+
+// a chunk went missing: the message is dropped, the next one is reassembled again
+void test_lost_chunk(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING, feed(1, OP_TEXT, 0, true, 0, 9, "abc"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_ERROR,   feed(1, OP_TEXT, 0, true, 6, 9, "ghi"));
+  TEST_ASSERT_NULL(msg);
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_TEXT, 0, true, 0, 2, "ok"));
+  assertMessage("ok", OP_TEXT);
+}
+
+// a whole frame went missing: the rest of the message is discarded
+void test_lost_frame(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING, feed(1, OP_TEXT, 0, false, 0, 3, "abc"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_ERROR,   feed(1, OP_CONT, 2, false, 0, 3, "ghi"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING, feed(1, OP_CONT, 3, true, 0, 3, "jkl"));
+  TEST_ASSERT_NULL(msg);
+  // continuation without a started message is ignored
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING, feed(1, OP_CONT, 4, true, 0, 3, "mno"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_TEXT, 0, true, 0, 2, "ok"));
+  assertMessage("ok", OP_TEXT);
+}
+
+// chunk reaching beyond its frame is not trusted
+void test_chunk_exceeds_frame(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING, feed(1, OP_TEXT, 0, false, 0, 4, "ab"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_ERROR,   feed(1, OP_TEXT, 0, false, 2, 4, "cdef"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING, feed(1, OP_CONT, 1, true, 0, 2, "gh"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_TEXT, 0, true, 0, 2, "ok"));
+  assertMessage("ok", OP_TEXT);
+}
+
+// client starts a new message before finishing the previous one (e.g. after reconnecting)
+void test_restart(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_PENDING,  feed(1, OP_TEXT, 0, false, 0, 3, "old"));
+  TEST_ASSERT_EQUAL_UINT8(WS_FRAGMENT_COMPLETE, feed(1, OP_BINARY, 0, true, 0, 3, "new"));
+  assertMessage("new", OP_BINARY);
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_single_frame);
+  RUN_TEST(test_chunked_frame);
+  RUN_TEST(test_chunked_frames);
+  RUN_TEST(test_empty_final_frame);
+  RUN_TEST(test_empty_message);
+  RUN_TEST(test_over_limit);
+  RUN_TEST(test_at_limit);
+  RUN_TEST(test_interleaved_clients);
+  RUN_TEST(test_no_free_slot);
+  RUN_TEST(test_lost_chunk);
+  RUN_TEST(test_lost_frame);
+  RUN_TEST(test_chunk_exceeds_frame);
+  RUN_TEST(test_restart);
+  return UNITY_END();
+}
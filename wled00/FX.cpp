@@ -4573,6 +4573,39 @@ static const char _data_FX_MODE_FLOWSTRIPE[] PROGMEM = "Flow Stripe@Hue speed,Ef
 //***************************  2D routines  ***********************************
 #define XY(x,y) SEGMENT.XY(x,y)
 
+// Field rendering helpers for effects that evaluate an expensive function for every pixel
+// (Julia, Metaballs). Instead of rendering the whole field each frame, such effects render
+// rows until FX_FIELD_BUDGET "work units" (iterations) are spent and continue on the next call.
+// Budget is scaled by segment quality (frame budget governor).
+#ifndef FX_FIELD_BUDGET
+  #ifdef ESP8266
+    #define FX_FIELD_BUDGET 12288
+  #else
+    #define FX_FIELD_BUDGET 49152
+  #endif
+#endif
+
+// Q16.16 fixed point multiplication (avoids soft-float on ESP8266)
+#define Q16_ONE 65536
+static inline int32_t mulQ16(int32_t a, int32_t b) { return (int32_t)(((int64_t)a * b) >> 16); }
+
+// returns next row to render; rows are visited in bit-reversed order (0, N/2, N/4, 3N/4, ...)
+// so that a partially rendered frame is spread (interlaced) across the whole segment
+// cursor has to persist between calls (i.e. SEGENV.aux0)
+static inline uint32_t fieldBudget() { return (FX_FIELD_BUDGET * (SEGMENT.quality() + 1U)) >> 8; }
+
+static uint16_t fieldNextRow(uint16_t &cursor, uint16_t rows) {
+  uint8_t bits = 0;
+  while ((1U << bits) < rows) bits++;
+  uint16_t row;
+  do {
+    uint16_t k = cursor++ & ((1U << bits) - 1);
+    row = 0;
+    for (size_t b = 0; b < bits; b++) if (k & (1U << b)) row |= 1U << (bits - 1 - b);
+  } while (row >= rows);
+  return row;
+}
+
 
 // Black hole
 uint16_t mode_2DBlackHole(void) {            // By: Stepko https://editor.soulmatelights.com/gallery/1012 , Modified by: Andrew Tuline
@@ -5012,14 +5045,7 @@ uint16_t mode_2DJulia(void) {                           // An animated Julia set
   ymin = constrain(ymin, -0.8f, 1.0f);
   ymax = constrain(ymax, -0.8f, 1.0f);
 
-  float dx;                       // Delta x is mapped to the matrix size.
-  float dy;                       // Delta y is mapped to the matrix size.
-
-  int maxIterations = 15;         // How many iterations per pixel before we give up. Make it 8 bits to match our range of colours.
-  float maxCalc = 16.0;           // How big is each calculation allowed to be before we give up.
-
-  maxIterations = SEGMENT.intensity/2;
-
+  int maxIterations = SEGMENT.intensity/2; // How many iterations per pixel before we give up.
 
   // Resize section on the fly for some animaton.
   reAl = -0.94299f;               // PixelBlaze example
@@ -5028,35 +5054,42 @@ uint16_t mode_2DJulia(void) {                           // An animated Julia set
   reAl += sin_t((float)millis()/305.f)/20.f;
   imAg += sin_t((float)millis()/405.f)/20.f;
 
-  dx = (xmax - xmin) / (cols);     // Scale the delta x and y values to our matrix size.
-  dy = (ymax - ymin) / (rows);
-
-  // Start y
-  float y = ymin;
-  for (int j = 0; j < rows; j++) {
-
-    // Start x
-    float x = xmin;
+  // convert frame parameters to Q16.16 fixed point, per pixel math is integer only
+  const int32_t cRe  = reAl * Q16_ONE;
+  const int32_t cIm  = imAg * Q16_ONE;
+  const int32_t re0  = xmin * Q16_ONE;
+  const int32_t im0  = ymin * Q16_ONE;
+  const int32_t dx   = (xmax - xmin) * Q16_ONE / cols; // Delta x is mapped to the matrix size.
+  const int32_t dy   = (ymax - ymin) * Q16_ONE / rows; // Delta y is mapped to the matrix size.
+  const int32_t maxCalc = 16 * Q16_ONE;                // How big is each calculation allowed to be before we give up.
+
+  // render as many rows as the budget allows, continue with the rest in the next frame
+  const uint32_t budget = fieldBudget();
+  uint32_t work = 0;
+  for (int n = 0; n < rows && work < budget; n++) {
+    int j = fieldNextRow(SEGENV.aux0, rows);
+    int32_t y = im0 + j * dy;
+    int32_t x = re0;
     for (int i = 0; i < cols; i++) {
 
       // Now we test, as we iterate z = z^2 + c does z tend towards infinity?
-      float a = x;
-      float b = y;
+      int32_t a = x;
+      int32_t b = y;
       int iter = 0;
 
       while (iter < maxIterations) {    // Here we determine whether or not we're out of bounds.
-        float aa = a * a;
-        float bb = b * b;
-        float len = aa + bb;
-        if (len > maxCalc) {            // |z| = sqrt(a^2+b^2) OR z^2 = a^2+b^2 to save on having to perform a square root.
+        int32_t aa = mulQ16(a, a);
+        int32_t bb = mulQ16(b, b);
+        if (aa + bb > maxCalc) {        // |z| = sqrt(a^2+b^2) OR z^2 = a^2+b^2 to save on having to perform a square root.
           break;  // Bail
         }
 
        // This operation corresponds to z -> z^2+c where z=a+ib c=(x,y). Remember to use 'foil'.
-        b = 2*a*b + imAg;
-        a = aa - bb + reAl;
+        b = 2*mulQ16(a, b) + cIm;
+        a = aa - bb + cRe;
         iter++;
       } // while
+      work += iter + 1;
 
       // We color each pixel based on how long it takes to get to infinity, or black if it never gets there.
       if (iter == maxIterations) {
@@ -5066,7 +5099,6 @@ uint16_t mode_2DJulia(void) {                           // An animated Julia set
       }
       x += dx;
     }
-    y += dy;
   }
 //  SEGMENT.blur(64);
 
@@ -5187,21 +5219,27 @@ uint16_t mode_2Dmetaballs(void) {   // Metaballs by Stefan Petrick. Cannot have
   uint8_t x1 = beatsin8(23 * speed, 0, cols-1);
   uint8_t y1 = beatsin8(28 * speed, 0, rows-1);
 
-  for (int y = 0; y < rows; y++) {
+  // render as many rows as the budget allows (3 sqrt16() per pixel), continue in the next frame
+  const uint32_t budget = fieldBudget();
+  uint32_t work = 0;
+  int n = 0;
+  for (; n < rows && work < budget; n++, work += cols * 8) {
+    int y = fieldNextRow(SEGENV.aux0, rows);
+    // vertical distances are constant along the row
+    uint16_t dy1 = abs(y - y1); dy1 *= dy1;
+    uint16_t dy2 = abs(y - y2); dy2 *= dy2;
+    uint16_t dy3 = abs(y - y3); dy3 *= dy3;
     for (int x = 0; x < cols; x++) {
       // calculate distances of the 3 points from actual pixel
       // and add them together with weightening
       uint16_t dx = abs(x - x1);
-      uint16_t dy = abs(y - y1);
-      uint16_t dist = 2 * sqrt16((dx * dx) + (dy * dy));
+      uint16_t dist = 2 * sqrt16((dx * dx) + dy1);
 
       dx = abs(x - x2);
-      dy = abs(y - y2);
-      dist += sqrt16((dx * dx) + (dy * dy));
+      dist += sqrt16((dx * dx) + dy2);
 
       dx = abs(x - x3);
-      dy = abs(y - y3);
-      dist += sqrt16((dx * dx) + (dy * dy));
+      dist += sqrt16((dx * dx) + dy3);
 
       // inverse result
       byte color = dist ? 1000 / dist : 255;
@@ -5212,12 +5250,17 @@ uint16_t mode_2Dmetaballs(void) {   // Metaballs by Stefan Petrick. Cannot have
       } else {
         SEGMENT.setPixelColorXY(x, y, SEGMENT.color_from_palette(0, false, PALETTE_SOLID_WRAP, 0));
       }
-      // show the 3 points, too
-      SEGMENT.setPixelColorXY(x1, y1, WHITE);
-      SEGMENT.setPixelColorXY(x2, y2, WHITE);
-      SEGMENT.setPixelColorXY(x3, y3, WHITE);
     }
   }
+  // show the 3 points, too, but only on a completed field (a pass has exactly rows rows),
+  // rows not rendered yet would keep them as trails
+  SEGENV.aux1 += n;
+  if (SEGENV.aux1 >= rows) {
+    SEGENV.aux1 %= rows;
+    SEGMENT.setPixelColorXY(x1, y1, WHITE);
+    SEGMENT.setPixelColorXY(x2, y2, WHITE);
+    SEGMENT.setPixelColorXY(x3, y3, WHITE);
+  }
 
   return FRAMETIME;
 } // mode_2Dmetaballs()
@@ -5839,6 +5882,13 @@ static const char _data_FX_MODE_2DBLOBS[] PROGMEM = "Blobs@!,# blobs,Blur;!;!;2;
 ////////////////////////////
 //     2D Scrolling text  //
 ////////////////////////////
+// rasterized text is kept in segment data: header followed by 1 bit strip (one uint16_t per column)
+typedef struct TextStrip {
+  char    text[WLED_MAX_SEGNAME_LEN+1]; // text that was rasterized
+  uint8_t letterWidth;                  // font used
+  uint8_t letterHeight;
+} textstrip;
+
 uint16_t mode_2Dscrollingtext(void) {
   if (!strip.isMatrix) return mode_static(); // not a 2D set-up
 
@@ -5894,14 +5944,47 @@ uint16_t mode_2Dscrollingtext(void) {
         SEGMENT.blendPixelColorXY(x, y, SEGCOLOR(1), 255 - (SEGMENT.custom1>>1));
     }
   }
+
+  uint32_t col1 = SEGMENT.color_from_palette(SEGENV.aux1, false, PALETTE_SOLID_WRAP, 0);
+  uint32_t col2 = BLACK;
+  if (SEGMENT.check1 && SEGMENT.palette == 0) {
+    col1 = SEGCOLOR(0);
+    col2 = SEGCOLOR(2);
+  }
+
+  // rasterize text only when it (or font) changes, blit visible window of the strip each frame
+  const int textWidth = numberOfLetters * letterWidth;
+  if (SEGENV.allocateData(sizeof(TextStrip) + textWidth * sizeof(uint16_t))) {
+    TextStrip *ts = reinterpret_cast<TextStrip*>(SEGENV.data);
+    uint16_t *bits = reinterpret_cast<uint16_t*>(SEGENV.data + sizeof(TextStrip));
+    if (ts->letterWidth != letterWidth || ts->letterHeight != letterHeight || strcmp(ts->text, text)) {
+      Segment::rasterizeText(text, letterWidth, letterHeight, bits, textWidth);
+      strcpy(ts->text, text);
+      ts->letterWidth  = letterWidth;
+      ts->letterHeight = letterHeight;
+    }
+
+    CRGBPalette16 grad = CRGBPalette16(CRGB(col1), col2 ? CRGB(col2) : CRGB(col1));
+    uint32_t rowColor[16];
+    for (int r = 0; r < letterHeight; r++) {
+      CRGB c = ColorFromPalette(grad, (r+1)*255/letterHeight, 255, NOBLEND);
+      rowColor[r] = RGBW32(c.r, c.g, c.b, 0);
+    }
+    const int x0 = int(cols) - int(SEGENV.aux0); // screen position of the first strip column
+    for (int x = MAX(x0, 0); x < MIN(x0 + textWidth, int(cols)); x++) {
+      const uint16_t column = bits[x - x0];
+      if (!column) continue;
+      for (int r = 0; r < letterHeight; r++) {
+        const int y = yoffset + r;
+        if (y >= 0 && y < rows && (column & (1U << r))) SEGMENT.setPixelColorXY(x, y, rowColor[r]);
+      }
+    }
+    return FRAMETIME;
+  }
+
+  // not enough memory for text strip: draw character by character
   for (int i = 0; i < numberOfLetters; i++) {
     if (int(cols) - int(SEGENV.aux0) + letterWidth*(i+1) < 0) continue; // don't draw characters off-screen
-    uint32_t col1 = SEGMENT.color_from_palette(SEGENV.aux1, false, PALETTE_SOLID_WRAP, 0);
-    uint32_t col2 = BLACK;
-    if (SEGMENT.check1 && SEGMENT.palette == 0) {
-      col1 = SEGCOLOR(0);
-      col2 = SEGCOLOR(2);
-    }
     SEGMENT.drawCharacter(text[i], int(cols) - int(SEGENV.aux0) + letterWidth*i, yoffset, letterWidth, letterHeight, col1, col2);
   }
 
@@ -7483,42 +7566,39 @@ uint16_t mode_2Doctopus() {
 
   const uint16_t cols = SEGMENT.virtualWidth();
   const uint16_t rows = SEGMENT.virtualHeight();
-  const uint8_t mapp = 180 / MAX(cols,rows);
 
-  typedef struct {
-    uint8_t angle;
-    uint8_t radius;
-  } map_t;
+  if (SEGENV.call == 0) SEGENV.step = 0; // t
 
-  const size_t dataSize = SEGMENT.width() * SEGMENT.height() * sizeof(map_t); // prevent reallocation if mirrored or grouped
-  if (!SEGENV.allocateData(dataSize + 2)) return mode_static(); //allocation failed
-
-  map_t *rMap = reinterpret_cast<map_t*>(SEGENV.data);
-  uint8_t *offsX = reinterpret_cast<uint8_t*>(SEGENV.data + dataSize);
-  uint8_t *offsY = reinterpret_cast<uint8_t*>(SEGENV.data + dataSize + 1);
-
-  // re-init if SEGMENT dimensions or offset changed
-  if (SEGENV.call == 0 || SEGENV.aux0 != cols || SEGENV.aux1 != rows || SEGMENT.custom1 != *offsX || SEGMENT.custom2 != *offsY) {
-    SEGENV.step = 0; // t
-    SEGENV.aux0 = cols;
-    SEGENV.aux1 = rows;
-    *offsX = SEGMENT.custom1;
-    *offsY = SEGMENT.custom2;
-    const int C_X = (cols / 2) + ((SEGMENT.custom1 - 128)*cols)/255;
-    const int C_Y = (rows / 2) + ((SEGMENT.custom2 - 128)*rows)/255;
-    for (int x = 0; x < cols; x++) {
-      for (int y = 0; y < rows; y++) {
-        rMap[XY(x, y)].angle  = 40.7436f * atan2f((y - C_Y), (x - C_X));  // avoid 128*atan2()/PI
-        rMap[XY(x, y)].radius = hypotf((x - C_X), (y - C_Y)) * mapp;      //thanks Sutaburosu
-      }
-    }
+  // polar coordinates are shared with other radial effects and only rebuilt if dimensions or offset change
+  const int C_X = (cols / 2) + ((SEGMENT.custom1 - 128)*cols)/255;
+  const int C_Y = (rows / 2) + ((SEGMENT.custom2 - 128)*rows)/255;
+  const WS2812FX::Polar *rMap = strip.getPolarMap(cols, rows, C_X, C_Y);
+  if (rMap) {
+    SEGENV.deallocateData();
+    SEGENV.aux0 = 0; // own map has to be rebuilt if needed later
+  } else {
+    // pool is busy with other geometries: keep own map in segment data
+    const size_t dataSize = cols * rows * sizeof(WS2812FX::Polar);
+    if (!SEGENV.allocateData(dataSize + 2)) return mode_static(); //allocation failed
+    WS2812FX::Polar *ownMap = reinterpret_cast<WS2812FX::Polar*>(SEGENV.data);
+    uint8_t *offsX = SEGENV.data + dataSize;
+    uint8_t *offsY = SEGENV.data + dataSize + 1;
+    // re-init if new, SEGMENT dimensions or offset changed
+    if (SEGENV.aux0 != cols || SEGENV.aux1 != rows || SEGMENT.custom1 != *offsX || SEGMENT.custom2 != *offsY) {
+      SEGENV.aux0 = cols;
+      SEGENV.aux1 = rows;
+      *offsX = SEGMENT.custom1;
+      *offsY = SEGMENT.custom2;
+      WS2812FX::fillPolarMap(ownMap, cols, rows, C_X, C_Y);
+    }
+    rMap = ownMap;
   }
 
   SEGENV.step += SEGMENT.speed / 32 + 1;  // 1-4 range
   for (int x = 0; x < cols; x++) {
     for (int y = 0; y < rows; y++) {
-      byte angle = rMap[XY(x,y)].angle;
-      byte radius = rMap[XY(x,y)].radius;
+      byte angle = rMap[x + y * cols].angle;
+      byte radius = rMap[x + y * cols].radius;
       //CRGB c = CHSV(SEGENV.step / 2 - radius, 255, sin8(sin8((angle * 4 - radius) / 4 + SEGENV.step) + radius - SEGENV.step * 2 + angle * (SEGMENT.custom3/3+1)));
       uint16_t intensity = sin8(sin8((angle * 4 - radius) / 4 + SEGENV.step/2) + radius - SEGENV.step + angle * (SEGMENT.custom3/4+1));
       intensity = map(intensity*intensity, 0, 65535, 0, 255); // add a bit of non-linearity for cleaner display
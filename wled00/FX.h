@@ -370,6 +370,7 @@ typedef struct Segment {
     };
     uint8_t startY;  // start Y coodrinate 2D (top); there should be no more than 255 rows
     uint8_t stopY;   // stop Y coordinate 2D (bottom); there should be no more than 255 rows
+    uint8_t renderScale; // 2D effect render resolution (0 = full, 1 = 1/2, 2 = 1/4), bilinearly upscaled
     char    *name;
 
     // runtime data
@@ -393,6 +394,13 @@ typedef struct Segment {
       };
     };
     uint16_t        _dataLen;
+    uint32_t       *_lowResBuf;   // reduced resolution render buffer (renderScale > 0)
+    uint16_t        _lowResLen;   // pixels in _lowResBuf
+    bool            _lowResActive;// effect is rendering into _lowResBuf, virtual dimensions are reduced
+    uint16_t        _renderTime; // time (us) effect function took in last frame
+    uint8_t         _quality;    // effect quality set by frame budget governor (255 = full)
+    uint8_t         _govScale;   // render scale forced by frame budget governor (2D, low quality)
+    bool            _adaptive;   // effect honours quality()
     static uint16_t _usedSegmentData;
 
     // perhaps this should be per segment, not static
@@ -459,6 +467,7 @@ typedef struct Segment {
       check3(false),
       startY(0),
       stopY(1),
+      renderScale(0),
       name(nullptr),
       next_time(0),
       step(0),
@@ -468,6 +477,13 @@ typedef struct Segment {
       data(nullptr),
       _capabilities(0),
       _dataLen(0),
+      _lowResBuf(nullptr),
+      _lowResLen(0),
+      _lowResActive(false),
+      _renderTime(0),
+      _quality(255),
+      _govScale(0),
+      _adaptive(false),
       _t(nullptr)
     {
       //refreshLightCapabilities();
@@ -491,6 +507,7 @@ typedef struct Segment {
       if (name) { delete[] name; name = nullptr; }
       if (_t)   { transitional = false; delete _t; _t = nullptr; }
       deallocateData();
+      deallocateLowRes();
     }
 
     Segment& operator= (const Segment &orig); // copy assignment
@@ -512,6 +529,17 @@ typedef struct Segment {
     inline uint16_t length(void)         const { return width() * height(); }               // segment length (count) in physical pixels
     inline uint16_t groupLength(void)    const { return grouping + spacing; }
     inline uint8_t  getLightCapabilities(void) const { return _capabilities; }
+    inline uint16_t getRenderTime(void)  const { return _renderTime; }
+    inline uint8_t  getQuality(void)     const { return _quality; }
+    inline uint8_t  getRenderScale(void) const { return MAX(renderScale, _govScale); } // effective render scale
+    /**
+      * Quality (0-255) the effect should render with, lowered by the frame budget governor
+      * if effects take too long to render. Effects that can trade quality for speed
+      * (iterations, particles, update stride) scale their work by it; calling it makes the
+      * segment eligible for quality reduction. On 2D segments low quality also reduces the
+      * render resolution (half below 128, quarter below 96).
+      */
+    inline uint8_t  quality(void)              { _adaptive = true; return _quality; }
 
     static uint16_t getUsedSegmentData(void)    { return _usedSegmentData; }
     static void     addUsedSegmentData(int len) { _usedSegmentData += len; }
@@ -531,6 +559,7 @@ typedef struct Segment {
     inline uint16_t dataSize(void) const { return _dataLen; }
     bool allocateData(size_t len);
     void deallocateData(void);
+    void deallocateLowRes(void);
     void resetIfRequired(void);
     /**
       * Flags that before the next effect is calculated,
@@ -607,11 +636,15 @@ typedef struct Segment {
     void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, uint32_t color, uint32_t col2 = 0);
     void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, CRGB c) { drawCharacter(chr, x, y, w, h, RGBW32(c.r,c.g,c.b,0)); } // automatic inline
     void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, CRGB c, CRGB c2) { drawCharacter(chr, x, y, w, h, RGBW32(c.r,c.g,c.b,0), RGBW32(c2.r,c2.g,c2.b,0)); } // automatic inline
+    static uint8_t  getFontRow(unsigned char chr, uint8_t row, uint8_t w, uint8_t h);
+    static uint16_t rasterizeText(const char *text, uint8_t w, uint8_t h, uint16_t *strip, uint16_t maxCols);
     void wu_pixel(uint32_t x, uint32_t y, CRGB c);
     void blur1d(fract8 blur_amount); // blur all rows in 1 dimension
     void blur2d(fract8 blur_amount) { blur(blur_amount); }
     void fill_solid(CRGB c) { fill(RGBW32(c.r,c.g,c.b,0)); }
     void nscale8(uint8_t scale);
+    bool beginLowRes(void); // start rendering into reduced resolution buffer (if renderScale > 0)
+    void endLowRes(void);   // upscale reduced resolution buffer into segment
   #else
     uint16_t XY(uint16_t x, uint16_t y)                                    { return x; }
     void setPixelColorXY(int x, int y, uint32_t c)                         { setPixelColor(x, c); }
@@ -638,8 +671,13 @@ typedef struct Segment {
     void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, CRGB c) {}
     void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, uint32_t color) {}
     void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, CRGB color) {}
+    static uint8_t  getFontRow(unsigned char chr, uint8_t row, uint8_t w, uint8_t h) { return 0; }
+    static uint16_t rasterizeText(const char *text, uint8_t w, uint8_t h, uint16_t *strip, uint16_t maxCols) { return 0; }
     void wu_pixel(uint32_t x, uint32_t y, CRGB c) {}
+    bool beginLowRes(void) { return false; }
+    void endLowRes(void) {}
   #endif
+  friend class WS2812FX;
 } segment;
 //static int segSize = sizeof(Segment);
 
@@ -682,6 +720,11 @@ class WS2812FX {  // 96 bytes
       _targetFps(WLED_FPS),
       _frametime(FRAMETIME_FIXED),
       _cumulativeFps(2),
+      _renderTime(0),
+      _overBudget(0),
+      _underBudget(0),
+      _qualityDrops(0),
+      _qualityRaises(0),
       _isServicing(false),
       _isOffRefreshRequired(false),
       _hasWhiteChannel(false),
@@ -691,6 +734,9 @@ class WS2812FX {  // 96 bytes
       customMappingTable(nullptr),
       customMappingSize(0),
       _lastShow(0),
+#ifndef WLED_DISABLE_2D
+      _polarMaps{},
+#endif
       _segment_index(0),
       _mainSegment(0),
       _queuedChangesSegId(255),
@@ -716,6 +762,7 @@ class WS2812FX {  // 96 bytes
       _segments.clear();
 #ifndef WLED_DISABLE_2D
       panel.clear();
+      purgePolarMaps(true);
 #endif
       customPalettes.clear();
     }
@@ -769,6 +816,7 @@ class WS2812FX {  // 96 bytes
     inline bool isServicing(void) { return _isServicing; }
     inline bool hasWhiteChannel(void) {return _hasWhiteChannel;}
     inline bool isOffRefreshRequired(void) {return _isOffRefreshRequired;}
+    inline bool hasLedMap(void) {return customMappingSize > 0;}
 
     uint8_t
       paletteFade,
@@ -798,6 +846,8 @@ class WS2812FX {  // 96 bytes
       getFps();
 
     inline uint16_t getFrameTime(void) { return _frametime; }
+    inline uint16_t getQualityDrops(void) { return _qualityDrops; }
+    inline uint16_t getQualityRaises(void) { return _qualityRaises; }
     inline uint16_t getMinShowDelay(void) { return MIN_SHOW_DELAY; }
     inline uint16_t getLength(void) { return _length; } // 2D matrix may have less pixels than W*H
     inline uint16_t getTransition(void) { return _transitionDur; }
@@ -808,6 +858,7 @@ class WS2812FX {  // 96 bytes
       getPixelColor(uint16_t);
 
     inline uint32_t getLastShow(void) { return _lastShow; }
+    inline uint32_t getRenderTime(void) { return _renderTime; }
     inline uint32_t segColor(uint8_t i) { return _colors_t[i]; }
 
     const char *
@@ -853,6 +904,14 @@ class WS2812FX {  // 96 bytes
       {}
     } Panel;
     std::vector<Panel> panel;
+
+    // shared polar coordinates of logical pixels (for radial 2D effects)
+    typedef struct polar_t {
+      uint8_t angle;  // angle around center (256 == full circle)
+      uint8_t radius; // distance from center (180 / larger of segment dimensions per pixel)
+    } Polar;
+    const Polar* getPolarMap(uint16_t cols, uint16_t rows, int16_t cx, int16_t cy); // nullptr if pool is busy
+    static void fillPolarMap(Polar *map, uint16_t cols, uint16_t rows, int16_t cx, int16_t cy);
 #endif
 
     void
@@ -889,6 +948,11 @@ class WS2812FX {  // 96 bytes
     uint16_t _frametime;
     uint16_t _cumulativeFps;
 
+    // frame budget governor
+    uint32_t _renderTime;             // time (us) all effects took in last frame
+    uint8_t  _overBudget, _underBudget; // consecutive frames over/well under budget
+    uint16_t _qualityDrops, _qualityRaises;
+
     // will require only 1 byte
     struct {
       bool _isServicing          : 1;
@@ -908,6 +972,23 @@ class WS2812FX {  // 96 bytes
 
     unsigned long _lastShow;
 
+#ifndef WLED_DISABLE_2D
+    // polar map pool, maps are released when no effect requested them for a while
+    #ifndef WLED_MAX_POLAR_MAPS
+      #ifdef ESP8266
+        #define WLED_MAX_POLAR_MAPS 1
+      #else
+        #define WLED_MAX_POLAR_MAPS 2
+      #endif
+    #endif
+    struct {
+      Polar        *map;
+      uint16_t      cols, rows;
+      int16_t       cx, cy;
+      unsigned long lastUse;
+    } _polarMaps[WLED_MAX_POLAR_MAPS];
+#endif
+
     uint8_t _segment_index;
     uint8_t _mainSegment;
     uint8_t _queuedChangesSegId;
@@ -919,6 +1000,8 @@ class WS2812FX {  // 96 bytes
       estimateCurrentAndLimitBri(void);
 
     void
+      governQuality(uint32_t renderTime),
+      purgePolarMaps(bool force = false),
       setUpSegmentFromQueuedChanges(void);
 };
 
@@ -181,6 +181,71 @@ uint32_t WS2812FX::getPixelColorXY(uint16_t x, uint16_t y) {
   return busses.getPixelColor(index);
 }
 
+#ifndef WLED_DISABLE_2D
+// getPolarMap() - returns (lazily built) angle & radius of each logical pixel (index x + y*cols)
+// relative to center cx,cy; maps are kept in a small pool shared by all segments/effects
+// with the same dimensions and center and count towards MAX_SEGMENT_DATA
+// maps still in use are not evicted, if no slot is available nullptr is returned and the
+// effect has to keep its own map (see fillPolarMap())
+const WS2812FX::Polar* WS2812FX::getPolarMap(uint16_t cols, uint16_t rows, int16_t cx, int16_t cy) {
+  if (!cols || !rows) return nullptr;
+  size_t slot = 0;
+  for (size_t i = 0; i < WLED_MAX_POLAR_MAPS; i++) {
+    if (_polarMaps[i].map && _polarMaps[i].cols == cols && _polarMaps[i].rows == rows && _polarMaps[i].cx == cx && _polarMaps[i].cy == cy) {
+      _polarMaps[i].lastUse = millis();
+      return _polarMaps[i].map;
+    }
+    // reuse empty or least recently used slot
+    if (_polarMaps[slot].map && (!_polarMaps[i].map || _polarMaps[i].lastUse < _polarMaps[slot].lastUse)) slot = i;
+  }
+
+  auto &pm = _polarMaps[slot];
+  if (pm.map && millis() - pm.lastUse < 1000) return nullptr; // all maps in use by other geometries
+  if (pm.map) {
+    free(pm.map);
+    Segment::addUsedSegmentData(-(int)(pm.cols * pm.rows * sizeof(Polar)));
+    pm.map = nullptr;
+  }
+  const size_t len = cols * rows * sizeof(Polar);
+  if (Segment::getUsedSegmentData() + len > MAX_SEGMENT_DATA) return nullptr; //not enough memory
+  pm.map = (Polar*) malloc(len);
+  if (!pm.map) return nullptr;
+  Segment::addUsedSegmentData(len);
+  pm.cols = cols;
+  pm.rows = rows;
+  pm.cx   = cx;
+  pm.cy   = cy;
+  pm.lastUse = millis();
+
+  fillPolarMap(pm.map, cols, rows, cx, cy);
+  DEBUG_PRINTF("Polar map %dx%d created.\n", cols, rows);
+  return pm.map;
+}
+
+void WS2812FX::fillPolarMap(Polar *map, uint16_t cols, uint16_t rows, int16_t cx, int16_t cy) {
+  const uint8_t scale = 180 / MAX(cols, rows); // integer as in the original Octopus
+  for (int y = 0; y < rows; y++) {
+    for (int x = 0; x < cols; x++) {
+      map[x + y * cols].angle  = int(40.7436f * atan2f(y - cy, x - cx)); // avoid 128*atan2()/PI
+      map[x + y * cols].radius = MIN(hypotf(x - cx, y - cy) * scale, 255.0f);
+    }
+  }
+}
+#endif
+
+// release polar maps that were not requested by any effect for a while (or all if forced)
+void WS2812FX::purgePolarMaps(bool force) {
+#ifndef WLED_DISABLE_2D
+  for (size_t i = 0; i < WLED_MAX_POLAR_MAPS; i++) {
+    auto &pm = _polarMaps[i];
+    if (!pm.map || (!force && millis() - pm.lastUse < 1000)) continue;
+    free(pm.map);
+    Segment::addUsedSegmentData(-(int)(pm.cols * pm.rows * sizeof(Polar)));
+    pm.map = nullptr;
+  }
+#endif
+}
+
 ///////////////////////////////////////////////////////////
 // Segment:: routines
 ///////////////////////////////////////////////////////////
@@ -198,6 +263,7 @@ void /*IRAM_ATTR*/ Segment::setPixelColorXY(int x, int y, uint32_t col)
 {
   if (!isActive()) return; // not active
   if (x >= virtualWidth() || y >= virtualHeight() || x<0 || y<0) return;  // if pixel would fall out of virtual segment just exit
+  if (_lowResActive) { _lowResBuf[x + y * virtualWidth()] = col; return; } // brightness is applied when upscaling
 
   uint8_t _bri_t = currentBri(on ? opacity : 0);
   if (_bri_t < 255) {
@@ -286,6 +352,7 @@ void Segment::setPixelColorXY(float x, float y, uint32_t col, bool aa)
 uint32_t Segment::getPixelColorXY(uint16_t x, uint16_t y) {
   if (!isActive()) return 0; // not active
   if (x >= virtualWidth() || y >= virtualHeight() || x<0 || y<0) return 0;  // if pixel would fall out of virtual segment just exit
+  if (_lowResActive) return _lowResBuf[x + y * virtualWidth()];
   if (reverse  ) x = virtualWidth()  - x - 1;
   if (reverse_y) y = virtualHeight() - y - 1;
   if (transpose) { uint16_t t = x; x = y; y = t; } // swap X & Y if segment transposed
@@ -295,6 +362,57 @@ uint32_t Segment::getPixelColorXY(uint16_t x, uint16_t y) {
   return strip.getPixelColorXY(start + x, startY + y);
 }
 
+// beginLowRes() - if renderScale is set (or the governor reduced resolution), makes the effect render into
+// a reduced resolution buffer (virtualWidth()/virtualHeight() are reduced until endLowRes() is called)
+bool Segment::beginLowRes() {
+  if (!getRenderScale() || !is2D()) { deallocateLowRes(); return false; }
+  _lowResActive = true;
+  const uint16_t len = virtualWidth() * virtualHeight();
+  if (_lowResBuf && _lowResLen == len) return true;
+  deallocateLowRes();
+  if (Segment::getUsedSegmentData() + len * sizeof(uint32_t) > MAX_SEGMENT_DATA) return false; //not enough memory, render at full resolution
+  _lowResBuf = (uint32_t*) malloc(len * sizeof(uint32_t));
+  if (!_lowResBuf) return false;
+  Segment::addUsedSegmentData(len * sizeof(uint32_t));
+  _lowResLen = len;
+  // start from the current content (resolution changed): progressively rendered effects keep their picture
+  const int cols = virtualWidth(); // full resolution (deallocateLowRes() cleared _lowResActive)
+  const int rows = virtualHeight();
+  _lowResActive = true;
+  const int lw = virtualWidth();
+  const int lh = virtualHeight();
+  _lowResActive = false;
+  for (int y = 0; y < lh; y++) for (int x = 0; x < lw; x++) {
+    _lowResBuf[x + y * lw] = getPixelColorXY((2*x+1) * cols / (2*lw), (2*y+1) * rows / (2*lh));
+  }
+  _lowResActive = true;
+  return true;
+}
+
+// endLowRes() - bilinear upscale of the reduced resolution buffer into segment
+void Segment::endLowRes() {
+  if (!_lowResActive) return;
+  const int lw = virtualWidth();
+  const int lh = virtualHeight();
+  _lowResActive = false;
+  const int cols = virtualWidth();
+  const int rows = virtualHeight();
+  for (int y = 0; y < rows; y++) {
+    // sample at pixel centers (8.8 fixed point)
+    const int sy = MAX((((2*y+1) * lh) << 7) / rows - 128, 0);
+    const int y0 = sy >> 8;
+    const int y1 = MIN(y0 + 1, lh - 1);
+    for (int x = 0; x < cols; x++) {
+      const int sx = MAX((((2*x+1) * lw) << 7) / cols - 128, 0);
+      const int x0 = sx >> 8;
+      const int x1 = MIN(x0 + 1, lw - 1);
+      uint32_t top = color_blend(_lowResBuf[x0 + y0 * lw], _lowResBuf[x1 + y0 * lw], sx & 0xFF);
+      uint32_t bot = color_blend(_lowResBuf[x0 + y1 * lw], _lowResBuf[x1 + y1 * lw], sx & 0xFF);
+      setPixelColorXY(x, y, color_blend(top, bot, sy & 0xFF));
+    }
+  }
+}
+
 // Blends the specified color with the existing pixel color.
 void Segment::blendPixelColorXY(uint16_t x, uint16_t y, uint32_t color, uint8_t blend) {
   setPixelColorXY(x, y, color_blend(getPixelColorXY(x,y), color, blend));
@@ -563,15 +681,27 @@ void Segment::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint3
 #include "src/font/console_font_6x8.h"
 #include "src/font/console_font_7x9.h"
 
-// draws a raster font character on canvas
+// returns one row of a raster font character (leftmost pixel in MSB) or 0 if not available
 // only supports: 4x6=24, 5x8=40, 5x12=60, 6x8=48 and 7x9=63 fonts ATM
+uint8_t Segment::getFontRow(unsigned char chr, uint8_t row, uint8_t w, uint8_t h) {
+  if (chr < 32 || chr > 126 || row >= h) return 0; // only ASCII 32-126 supported
+  chr -= 32; // align with font table entries
+  switch (w*h) {
+    case 24: return pgm_read_byte_near(&console_font_4x6[(chr * h) + row]);  // 4x6 font
+    case 40: return pgm_read_byte_near(&console_font_5x8[(chr * h) + row]);  // 5x8 font
+    case 48: return pgm_read_byte_near(&console_font_6x8[(chr * h) + row]);  // 6x8 font
+    case 63: return pgm_read_byte_near(&console_font_7x9[(chr * h) + row]);  // 7x9 font
+    case 60: return pgm_read_byte_near(&console_font_5x12[(chr * h) + row]); // 5x12 font
+    default: return 0;
+  }
+}
+
+// draws a raster font character on canvas
 void Segment::drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, uint32_t color, uint32_t col2) {
   if (!isActive()) return; // not active
   if (chr < 32 || chr > 126) return; // only ASCII 32-126 supported
-  chr -= 32; // align with font table entries
   const uint16_t cols = virtualWidth();
   const uint16_t rows = virtualHeight();
-  const int font = w*h;
 
   CRGB col = CRGB(color);
   CRGBPalette16 grad = CRGBPalette16(col, col2 ? CRGB(col2) : col);
@@ -581,15 +711,7 @@ void Segment::drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w,
     int16_t y0 = y + i;
     if (y0 < 0) continue; // drawing off-screen
     if (y0 >= rows) break; // drawing off-screen
-    uint8_t bits = 0;
-    switch (font) {
-      case 24: bits = pgm_read_byte_near(&console_font_4x6[(chr * h) + i]); break;  // 5x8 font
-      case 40: bits = pgm_read_byte_near(&console_font_5x8[(chr * h) + i]); break;  // 5x8 font
-      case 48: bits = pgm_read_byte_near(&console_font_6x8[(chr * h) + i]); break;  // 6x8 font
-      case 63: bits = pgm_read_byte_near(&console_font_7x9[(chr * h) + i]); break;  // 7x9 font
-      case 60: bits = pgm_read_byte_near(&console_font_5x12[(chr * h) + i]); break; // 5x12 font
-      default: return;
-    }
+    uint8_t bits = getFontRow(chr, i, w, h);
     col = ColorFromPalette(grad, (i+1)*255/h, 255, NOBLEND);
     for (int j = 0; j<w; j++) { // character width
       int16_t x0 = x + (w-1) - j;
@@ -600,6 +722,21 @@ void Segment::drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w,
   }
 }
 
+// rasterizes text into a 1 bit strip (one uint16_t per column, bit n represents row n, h<=16)
+// returns number of columns written (at most maxCols)
+uint16_t Segment::rasterizeText(const char *text, uint8_t w, uint8_t h, uint16_t *strip, uint16_t maxCols) {
+  if (!text || !strip || h > 16) return 0;
+  uint16_t c = 0;
+  for (size_t i = 0; text[i] && c + w <= maxCols; i++, c += w) {
+    for (int j = 0; j < w; j++) strip[c+j] = 0;
+    for (int r = 0; r < h; r++) {
+      uint8_t bits = getFontRow(text[i], r, w, h);
+      for (int j = 0; j < w; j++) if (bits & (0x80 >> j)) strip[c+j] |= 1U << r;
+    }
+  }
+  return c;
+}
+
 #define WU_WEIGHT(a,b) ((uint8_t) (((a)*(b)+(a)+(b))>>8))
 void Segment::wu_pixel(uint32_t x, uint32_t y, CRGB c) {      //awesome wu_pixel procedure by reddit u/sutaburosu
   if (!isActive()) return; // not active
@@ -89,6 +89,9 @@ Segment::Segment(const Segment &orig) {
   name = nullptr;
   data = nullptr;
   _dataLen = 0;
+  _lowResBuf = nullptr;
+  _lowResLen = 0;
+  _lowResActive = false;
   _t = nullptr;
   if (orig.name) { name = new char[strlen(orig.name)+1]; if (name) strcpy(name, orig.name); }
   if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
@@ -103,6 +106,8 @@ Segment::Segment(Segment &&orig) noexcept {
   orig.name = nullptr;
   orig.data = nullptr;
   orig._dataLen = 0;
+  orig._lowResBuf = nullptr;
+  orig._lowResLen = 0;
   orig._t   = nullptr;
 }
 
@@ -115,6 +120,7 @@ Segment& Segment::operator= (const Segment &orig) {
     if (name) delete[] name;
     if (_t)   delete _t;
     deallocateData();
+    deallocateLowRes();
     // copy source
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     transitional = false;
@@ -122,6 +128,9 @@ Segment& Segment::operator= (const Segment &orig) {
     name = nullptr;
     data = nullptr;
     _dataLen = 0;
+    _lowResBuf = nullptr;
+    _lowResLen = 0;
+    _lowResActive = false;
     _t = nullptr;
     // copy source data
     if (orig.name) { name = new char[strlen(orig.name)+1]; if (name) strcpy(name, orig.name); }
@@ -138,12 +147,15 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     transitional = false; // just temporary
     if (name) { delete[] name; name = nullptr; } // free old name
     deallocateData(); // free old runtime data
+    deallocateLowRes();
     if (_t) { delete _t; _t = nullptr; }
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     orig.transitional = false; // old segment cannot be in transition
     orig.name = nullptr;
     orig.data = nullptr;
     orig._dataLen = 0;
+    orig._lowResBuf = nullptr;
+    orig._lowResLen = 0;
     orig._t   = nullptr;
   }
   return *this;
@@ -170,6 +182,15 @@ void Segment::deallocateData() {
   _dataLen = 0;
 }
 
+void Segment::deallocateLowRes() {
+  _lowResActive = false;
+  if (!_lowResBuf) return;
+  free(_lowResBuf);
+  _lowResBuf = nullptr;
+  Segment::addUsedSegmentData(-(int)(_lowResLen * sizeof(uint32_t)));
+  _lowResLen = 0;
+}
+
 /**
   * If reset of this segment was requested, clears runtime
   * settings of this segment.
@@ -444,6 +465,7 @@ void Segment::setMode(uint8_t fx, bool loadDefaults) {
     if (fx != mode) {
       if (fadeTransition) startTransition(strip.getTransition()); // set effect transitions
       mode = fx;
+      _quality = 255; _govScale = 0; _adaptive = false; // new effect starts with full quality
 
       // load default values from effect string
       if (loadDefaults) {
@@ -485,6 +507,7 @@ uint16_t Segment::virtualWidth() const {
   uint16_t groupLen = groupLength();
   uint16_t vWidth = ((transpose ? height() : width()) + groupLen - 1) / groupLen;
   if (mirror) vWidth = (vWidth + 1) /2;  // divide by 2 if mirror, leave at least a single LED
+  if (_lowResActive) vWidth = (vWidth + (1U << getRenderScale()) - 1) >> getRenderScale(); // effect renders at reduced resolution
   return vWidth;
 }
 
@@ -492,6 +515,7 @@ uint16_t Segment::virtualHeight() const {
   uint16_t groupLen = groupLength();
   uint16_t vHeight = ((transpose ? width() : height()) + groupLen - 1) / groupLen;
   if (mirror_y) vHeight = (vHeight + 1) /2;  // divide by 2 if mirror, leave at least a single LED
+  if (_lowResActive) vHeight = (vHeight + (1U << getRenderScale()) - 1) >> getRenderScale(); // effect renders at reduced resolution
   return vHeight;
 }
 
@@ -731,6 +755,7 @@ uint8_t Segment::differs(Segment& b) const {
   if (custom3 != b.custom3)     d |= SEG_DIFFERS_FX;
   if (startY != b.startY)       d |= SEG_DIFFERS_BOUNDS;
   if (stopY != b.stopY)         d |= SEG_DIFFERS_BOUNDS;
+  if (renderScale != b.renderScale) d |= SEG_DIFFERS_OPT;
 
   //bit pattern: (msb first) set:2, sound:1, mapping:3, transposed, mirrorY, reverseY, [transitional, reset,] paused, mirrored, on, reverse, [selected]
   if ((options & 0b1111111110011110U) != (b.options & 0b1111111110011110U)) d |= SEG_DIFFERS_OPT;
@@ -1069,6 +1094,7 @@ void WS2812FX::service() {
   now = nowUp + timebase;
   if (nowUp - _lastShow < MIN_SHOW_DELAY) return;
   bool doShow = false;
+  uint32_t renderTime = 0;
 
   _isServicing = true;
   _segment_index = 0;
@@ -1086,6 +1112,7 @@ void WS2812FX::service() {
       uint16_t delay = FRAMETIME;
 
       if (!seg.freeze) { //only run effect function if not frozen
+        bool lowRes = seg.beginLowRes(); // reduces virtual dimensions if segment renders at lower resolution
         _virtualSegmentLength = seg.virtualLength();
         _colors_t[0] = seg.currentColor(0, seg.colors[0]);
         _colors_t[1] = seg.currentColor(1, seg.colors[1]);
@@ -1098,7 +1125,11 @@ void WS2812FX::service() {
         // effect blending (execute previous effect)
         // actual code may be a bit more involved as effects have runtime data including allocated memory
         //if (seg.transitional && seg._modeP) (*_mode[seg._modeP])(progress());
+        unsigned long start = micros();
         delay = (*_mode[seg.currentMode(seg.mode)])();
+        if (lowRes) seg.endLowRes(); // upscale into segment
+        seg._renderTime = MIN(micros() - start, 65535UL);
+        renderTime += seg._renderTime;
         if (seg.mode != FX_MODE_HALLOWEEN_EYES) seg.call++;
         if (seg.transitional && delay > FRAMETIME) delay = FRAMETIME; // force faster updates during transition
       }
@@ -1110,6 +1141,7 @@ void WS2812FX::service() {
   }
   _virtualSegmentLength = 0;
   busses.setSegmentCCT(-1);
+  purgePolarMaps();
   _isServicing = false;
   _triggered = false;
 
@@ -1117,6 +1149,7 @@ void WS2812FX::service() {
   if (millis() - nowUp > _frametime) DEBUG_PRINTLN(F("Slow effects."));
   #endif
   if (doShow) {
+    governQuality(renderTime);
     yield();
     show();
   }
@@ -1125,6 +1158,57 @@ void WS2812FX::service() {
   #endif
 }
 
+#ifndef WLED_DISABLE_2D
+// resolution knob: 2D segments render at half/quarter resolution at low quality
+static uint8_t governorScale(Segment &seg, uint8_t quality) {
+  return !seg.is2D() ? 0 : quality < 96 ? 2 : quality < 128 ? 1 : 0;
+}
+#endif
+
+// frame budget governor: if effects take longer than frame time to render for several
+// consecutive frames lower quality of the most expensive adaptive segment, restore
+// quality (least degraded segment first) when there is plenty of headroom again
+void WS2812FX::governQuality(uint32_t renderTime) {
+  const uint32_t budget = _frametime * 1000U; // in us
+  _renderTime = renderTime;
+  if (renderTime > budget) {
+    _underBudget = 0;
+    if (++_overBudget < 3) return;
+  } else if (renderTime < budget/2) {
+    _overBudget = 0;
+    if (_underBudget < 255) _underBudget++;
+    if (_underBudget < 50) return;
+  } else {
+    _overBudget = _underBudget = 0;
+    return;
+  }
+
+  Segment *target = nullptr;
+  for (segment &seg : _segments) {
+    if (!seg.isActive() || !seg._adaptive) continue;
+    if (_overBudget) { // pick most expensive segment that can still be degraded
+      if (seg._quality > 63 && (!target || seg._renderTime > target->_renderTime)) target = &seg;
+    } else {           // pick least degraded segment that is not at full quality
+      if (seg._quality < 255 && (!target || seg._quality > target->_quality)) target = &seg;
+    }
+  }
+  if (target) {
+    uint8_t quality = _overBudget ? target->_quality - 32 : target->_quality > 223 ? 255 : target->_quality + 32;
+#ifndef WLED_DISABLE_2D
+    // restoring a resolution step renders 4 times the pixels: only with a lot of headroom for a long time,
+    // otherwise the segment would oscillate between two resolutions
+    uint8_t scale = governorScale(*target, quality);
+    if (scale < target->_govScale && (_underBudget < 250 || renderTime >= budget/4)) return;
+    target->_govScale = scale; // effect keeps its data, low resolution buffer is resampled on size change
+#endif
+    target->_quality = quality;
+    if (_overBudget) _qualityDrops++;
+    else             _qualityRaises++;
+    DEBUG_PRINTF("Quality of segment %d set to %d (%uus/frame).\n", (int)(target - &_segments[0]), (int)target->_quality, (unsigned)renderTime);
+  }
+  _overBudget = _underBudget = 0;
+}
+
 void IRAM_ATTR WS2812FX::setPixelColor(int i, uint32_t col)
 {
   if (i < customMappingSize) i = customMappingTable[i];
@@ -1663,6 +1747,7 @@ void WS2812FX::loadCustomPalettes() {
       break;
     }
   }
+  invalidateJsonCache(); // palette previews (/json/palx) have to be rebuilt
 }
 
 //load custom mapping table from JSON file (called from finalizeInit() or deserializeState())
@@ -5,7 +5,6 @@
 * NodeStruct from the ESP Easy project (https://github.com/letscontrolit/ESPEasy)
 \*********************************************************************************************/
 
-#include <map>
 #include <IPAddress.h>
 
 #define NODE_TYPE_ID_UNDEFINED        0
@@ -15,13 +14,17 @@
 #define NODE_TYPE_ID_ESP32S3         34
 #define NODE_TYPE_ID_ESP32C3         35
 
+#define NODE_NAME_LEN                32 // same as serverDescription
+#define NODE_MAX_AGE                 10 // refresh cycles without info packet until a node is dropped
+
 /*********************************************************************************************\
 * NodeStruct
 \*********************************************************************************************/
 struct NodeStruct
 {
-  String    nodeName;
-  IPAddress ip;
+  uint32_t  ip;         // as IPAddress converts it, 0 = unused
+  uint32_t  build;
+  char      nodeName[NODE_NAME_LEN+1];
   uint8_t   age;
   union {
     uint8_t nodeType;   // a waste of space as we only have 5 types
@@ -30,13 +33,62 @@ struct NodeStruct
       bool    on   : 1;
     };
   };
-  uint32_t  build;
+};
+
+/*********************************************************************************************\
+* NodeTable: fixed capacity list of other WLED instances keyed by IP
+* Allocated as one block when the first node is seen, so many nodes do not fragment the heap.
+* If full, the node not heard of for the longest time is replaced.
+\*********************************************************************************************/
+class NodeTable
+{
+  public:
+    NodeTable() : _nodes(nullptr), _count(0) {}
+
+    // returns entry for ip, creating (or evicting for) it if needed, nullptr if out of memory
+    NodeStruct* update(IPAddress ip) {
+      uint32_t key = ip;
+      if (!key) return nullptr;
+      for (size_t i = 0; i < _count; i++) if (_nodes[i].ip == key) return &_nodes[i];
+      if (!_nodes) {
+        _nodes = (NodeStruct*)malloc(WLED_MAX_NODES * sizeof(NodeStruct));
+        if (!_nodes) return nullptr;
+      }
+      NodeStruct *node;
+      if (_count < WLED_MAX_NODES) {
+        node = &_nodes[_count++];
+      } else {
+        node = &_nodes[0];
+        for (size_t i = 1; i < _count; i++) if (_nodes[i].age > node->age) node = &_nodes[i];
+      }
+      memset(node, 0, sizeof(NodeStruct));
+      node->ip = key;
+      return node;
+    }
+
+    // increments age of all nodes and drops those that were silent for too long
+    void refresh() {
+      for (size_t i = 0; i < _count; ) {
+        if (_nodes[i].age < NODE_MAX_AGE) {
+          _nodes[i++].age++;
+        } else {
+          _nodes[i] = _nodes[--_count]; // order is not kept
+        }
+      }
+    }
+
+    void clear() {
+      free(_nodes);
+      _nodes = nullptr;
+      _count = 0;
+    }
+
+    size_t size() const { return _count; }
+    const NodeStruct& operator[](size_t i) const { return _nodes[i]; }
 
-  NodeStruct() : age(0), nodeType(0), build(0)
-  {
-    for (uint8_t i = 0; i < 4; ++i) { ip[i] = 0; }
-  }
+  private:
+    NodeStruct *_nodes;
+    size_t      _count;
 };
-typedef std::map<uint8_t, NodeStruct> NodesMap;
 
 #endif // WLED_NODESTRUCT_H
@@ -16,6 +16,7 @@ void colorRGBtoRGBW(byte* rgb);
 
 //udp.cpp
 uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, byte *buffer, uint8_t bri=255, bool isRGBW=false);
+bool queueRealtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, byte *buffer, uint8_t bri=255, bool isRGBW=false);
 
 // enable additional debug output
 #if defined(WLED_DEBUG_HOST)
@@ -502,6 +503,8 @@ uint32_t BusNetwork::getPixelColor(uint16_t pix) {
 
 void BusNetwork::show() {
   if (!_valid || !canShow()) return;
+  // only snapshot pixel data, packets are built and sent by network output task/loop
+  if (queueRealtimeBroadcast(_UDPtype, _client, _len, _data, _bri, _rgbw)) return;
   _broadcastLock = true;
   realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, _rgbw);
   _broadcastLock = false;
@@ -403,6 +403,12 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(syncGroups, if_sync_send["grp"]);
   if (if_sync_send[F("twice")]) udpNumRetries = 1; // import setting from 0.13 and earlier
   CJSON(udpNumRetries, if_sync_send["ret"]);
+  CJSON(syncDelta, if_sync_send[F("delta")]);
+  CJSON(clockSyncMode, if_sync[F("clock")]);
+  if (clockSyncMode > CLOCK_SYNC_FOLLOWER) clockSyncMode = CLOCK_SYNC_OFF;
+
+  CJSON(wsMaxMessageSize, interfaces[F("ws")][F("max")]);
+  if (wsMaxMessageSize < 1024) wsMaxMessageSize = 1024;
 
   JsonObject if_nodes = interfaces["nodes"];
   CJSON(nodeListEnabled, if_nodes[F("list")]);
@@ -424,8 +430,31 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   if (DMXSegmentSpacing > 150) DMXSegmentSpacing = 0;
   CJSON(e131Priority, if_live_dmx[F("e131prio")]);
   if (e131Priority > 200) e131Priority = 200;
+  CJSON(e131MergeMode, if_live_dmx[F("merge")]);
+  if (e131MergeMode > E131_MERGE_HTP) e131MergeMode = E131_MERGE_LTP;
+  CJSON(e131SourceTimeout, if_live_dmx[F("srcto")]);
+  if (e131SourceTimeout < 100) e131SourceTimeout = 100;
   CJSON(DMXMode, if_live_dmx["mode"]);
 
+  JsonObject if_live_out = if_live["out"]; // network bus output
+  CJSON(e131OutUniverse, if_live_out[F("e131uni")]);
+  e131OutUniverse = constrain(e131OutUniverse, 1, 63999);
+  CJSON(e131OutPriority, if_live_out[F("e131prio")]);
+  if (e131OutPriority > 200) e131OutPriority = 200;
+  CJSON(e131OutSyncUniverse, if_live_out[F("e131sync")]);
+  CJSON(artnetOutNet, if_live_out[F("annet")]);
+  CJSON(artnetOutSubnet, if_live_out[F("ansub")]);
+  CJSON(artnetOutUniverse, if_live_out[F("anuni")]);
+  artnetOutNet &= 0x7F; artnetOutSubnet &= 0x0F; artnetOutUniverse &= 0x0F;
+  CJSON(artnetOutChannels, if_live_out[F("anch")]);
+  artnetOutChannels = constrain(artnetOutChannels, 3, 512);
+  CJSON(artnetOutSync, if_live_out[F("ansync")]);
+  CJSON(artnetOutPacing, if_live_out[F("anpace")]);
+  if (artnetOutPacing > 5000) artnetOutPacing = 5000;
+
+  CJSON(realtimeFrameTimeout, if_live[F("frameto")]);
+  CJSON(ddpJitterDepth, if_live[F("jbuf")]);
+  if (ddpJitterDepth > WLED_MAX_JITTER_FRAMES) ddpJitterDepth = WLED_MAX_JITTER_FRAMES;
   tdd = if_live[F("timeout")] | -1;
   if (tdd >= 0) realtimeTimeoutMs = tdd * 100;
   CJSON(arlsForceMaxBri, if_live[F("maxbri")]);
@@ -864,6 +893,11 @@ void serializeConfig() {
   if_sync_send["macro"] = notifyMacro;
   if_sync_send["grp"] = syncGroups;
   if_sync_send["ret"] = udpNumRetries;
+  if_sync_send[F("delta")] = syncDelta;
+  if_sync[F("clock")] = clockSyncMode;
+
+  JsonObject if_ws = interfaces.createNestedObject(F("ws"));
+  if_ws[F("max")] = wsMaxMessageSize;
 
   JsonObject if_nodes = interfaces.createNestedObject("nodes");
   if_nodes[F("list")] = nodeListEnabled;
@@ -879,10 +913,25 @@ void serializeConfig() {
   if_live_dmx[F("uni")] = e131Universe;
   if_live_dmx[F("seqskip")] = e131SkipOutOfSequence;
   if_live_dmx[F("e131prio")] = e131Priority;
+  if_live_dmx[F("merge")] = e131MergeMode;
+  if_live_dmx[F("srcto")] = e131SourceTimeout;
   if_live_dmx[F("addr")] = DMXAddress;
   if_live_dmx[F("dss")] = DMXSegmentSpacing;
   if_live_dmx["mode"] = DMXMode;
 
+  JsonObject if_live_out = if_live.createNestedObject("out");
+  if_live_out[F("e131uni")] = e131OutUniverse;
+  if_live_out[F("e131prio")] = e131OutPriority;
+  if_live_out[F("e131sync")] = e131OutSyncUniverse;
+  if_live_out[F("annet")] = artnetOutNet;
+  if_live_out[F("ansub")] = artnetOutSubnet;
+  if_live_out[F("anuni")] = artnetOutUniverse;
+  if_live_out[F("anch")] = artnetOutChannels;
+  if_live_out[F("ansync")] = artnetOutSync;
+  if_live_out[F("anpace")] = artnetOutPacing;
+
+  if_live[F("frameto")] = realtimeFrameTimeout;
+  if_live[F("jbuf")] = ddpJitterDepth;
   if_live[F("timeout")] = realtimeTimeoutMs / 100;
   if_live[F("maxbri")] = arlsForceMaxBri;
   if_live[F("no-gc")] = arlsDisableGammaCorrection;
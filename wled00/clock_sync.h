@@ -0,0 +1,132 @@
+#ifndef WLED_CLOCK_SYNC_H
+#define WLED_CLOCK_SYNC_H
+
+/*
+ * Effect clock synchronisation (follower side filter, PTP-like request/reply exchange)
+ *
+ * Follower sends request at t1, master receives it at t2 and replies at t3, follower receives the reply at t4.
+ * t1/t4 are follower and t2/t3 master effect time (millis() + timebase) in us, wrapping at 32 bit.
+ * Of the last samples the one with the shortest round trip is trusted most, as it was delayed least.
+ * The resulting offset is slewed into the timebase in whole ms steps so effects do not visibly jump.
+ * All timestamps are passed in by the caller.
+ */
+
+#include <stdint.h>
+
+#define CLOCK_SYNC_SAMPLES 8
+#define CLOCK_SYNC_MAX_DELAY 200000   // us, replies with longer round trip are useless
+#define CLOCK_SYNC_STEP_LIMIT 50000   // us, larger offsets are stepped instead of slewed
+#define CLOCK_SYNC_AGE_PENALTY 500  // us added to the round trip of a sample per newer sample
+#define CLOCK_SYNC_SLEW_RATE 5        // ms correction per second while slewing (0.5%)
+
+class ClockSync {
+  public:
+    ClockSync() { reset(); }
+
+    void reset() {
+      _count = _next = _newest = 0;
+      _locked = false;
+      _pending = _offset = 0;
+      _jitter = _delay = 0;
+      _slewBudget = 0;
+      _lastSlew = 0;
+      _step = false;
+    }
+
+    // returns false if the sample was discarded
+    bool addSample(uint32_t t1, uint32_t t2, uint32_t t3, uint32_t t4) {
+      int32_t delay = (int32_t)(t4 - t1) - (int32_t)(t3 - t2);
+      if ((int32_t)(t4 - t1) < 0 || delay > CLOCK_SYNC_MAX_DELAY) return false;
+      if (delay < 0) delay = 0; // master turnaround measured longer than round trip, clock granularity
+      int32_t offset = (int32_t)(((int64_t)(int32_t)(t2 - t1) + (int64_t)(int32_t)(t3 - t4)) / 2);
+
+      // the offset may be wrong by up to half the round trip, only step if it is large even then
+      int32_t limit = CLOCK_SYNC_STEP_LIMIT + delay / 2;
+      if (!_locked || offset > limit || offset < -limit) {
+        // (re)acquire: jump to master time, samples taken on the old timebase are meaningless now
+        _count = _next = 0;
+        _pending = offset;
+        _offset = offset;
+        _delay = delay;
+        _jitter = 0;
+        _step = true;
+        _locked = true;
+        return true;
+      }
+
+      _samples[_next].offset = offset;
+      _samples[_next].delay  = delay;
+      _next = (_next + 1) % CLOCK_SYNC_SAMPLES;
+      if (_count < CLOCK_SYNC_SAMPLES) _count++;
+
+      // shortest round trip wins, older samples are handicapped as the clocks drift apart meanwhile
+      uint8_t best = _newest = (_next + CLOCK_SYNC_SAMPLES - 1) % CLOCK_SYNC_SAMPLES;
+      for (uint8_t i = 0; i < _count; i++) if (score(i) < score(best)) best = i;
+      int32_t dev = offset - _samples[best].offset;
+      if (dev < 0) dev = -dev;
+      _jitter = _jitter ? (_jitter * 7 + dev + 4) >> 3 : dev;
+      _offset = _samples[best].offset;
+      _delay  = _samples[best].delay;
+      _pending = _offset;
+      return true;
+    }
+
+    // returns ms to add to the local timebase now, call regularly
+    int32_t takeCorrection(uint32_t nowMs) {
+      int32_t ms = 0;
+      if (_step) {
+        ms = (_pending >= 0 ? _pending + 500 : _pending - 500) / 1000; // round to nearest
+        _step = false;
+        _slewBudget = 0;
+      } else {
+        uint32_t elapsed = nowMs - _lastSlew;
+        if (elapsed > 1000) elapsed = 1000;
+        _slewBudget += elapsed * CLOCK_SYNC_SLEW_RATE;
+        if (_slewBudget > 1000) _slewBudget = 1000; // no bursts after long pauses
+        if (_slewBudget >= 1000 && (_pending > 500 || _pending < -500)) {
+          ms = _pending > 0 ? 1 : -1;
+          _slewBudget -= 1000;
+        }
+      }
+      _lastSlew = nowMs;
+      if (ms) applied(ms * 1000);
+      return ms;
+    }
+
+    bool     isLocked()  const { return _locked; }
+    int32_t  getOffset() const { return _offset; }  // last filtered offset to master (us) before correction
+    uint32_t getJitter() const { return _jitter; }  // average deviation of samples from filtered offset (us)
+    uint32_t getDelay()  const { return _delay; }   // round trip of trusted sample (us)
+
+  private:
+    // local clock moved by us, stored samples are relative to the old timebase
+    void applied(int32_t us) {
+      _pending -= us;
+      for (uint8_t i = 0; i < _count; i++) _samples[i].offset -= us;
+    }
+
+    // age in samples, each sample is about a sync interval older than the next
+    int32_t score(uint8_t i) const {
+      uint8_t age = (_newest + CLOCK_SYNC_SAMPLES - i) % CLOCK_SYNC_SAMPLES;
+      return _samples[i].delay + age * CLOCK_SYNC_AGE_PENALTY;
+    }
+
+    struct Sample {
+      int32_t offset;
+      int32_t delay;
+    };
+    Sample   _samples[CLOCK_SYNC_SAMPLES];
+    int32_t  _pending;   // us still to be applied to the timebase
+    int32_t  _offset;
+    uint32_t _jitter;
+    uint32_t _delay;
+    uint32_t _slewBudget; // us that may be corrected
+    uint32_t _lastSlew;
+    uint8_t  _count;
+    uint8_t  _next;
+    uint8_t  _newest;
+    bool     _locked;
+    bool     _step;      // offset too large to slew
+};
+
+#endif
@@ -191,11 +191,20 @@
 #define REALTIME_MODE_TPM2NET     7
 #define REALTIME_MODE_DDP         8
 
+//realtime pixel data formats (bytes per pixel) for setRealtimePixels()
+#define REALTIME_PIXELS_RGB       3
+#define REALTIME_PIXELS_RGBW      4
+
 //realtime override modes
 #define REALTIME_OVERRIDE_NONE    0
 #define REALTIME_OVERRIDE_ONCE    1
 #define REALTIME_OVERRIDE_ALWAYS  2
 
+//effect clock sync roles
+#define CLOCK_SYNC_OFF            0
+#define CLOCK_SYNC_MASTER         1            //answer clock requests of followers in own sync groups
+#define CLOCK_SYNC_FOLLOWER       2            //slew timebase to master of receive groups
+
 //E1.31 DMX modes
 #define DMX_MODE_DISABLED         0            //not used
 #define DMX_MODE_SINGLE_RGB       1            //all LEDs same RGB color (3 channels)
@@ -251,7 +260,7 @@
 #define TYPE_LPD6803             54
 //Network types (master broadcast) (80-95)
 #define TYPE_NET_DDP_RGB         80            //network DDP RGB bus (master broadcast bus)
-#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus, unused)
+#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGB      82            //network ArtNet RGB bus (master broadcast bus, unused)
 #define TYPE_NET_DDP_RGBW        88            //network DDP RGBW bus (master broadcast bus)
 
@@ -445,6 +454,27 @@
   #define JSON_BUFFER_SIZE 24576
 #endif
 
+// Pool of documents for incoming JSON API commands (parsed without the global buffer lock)
+#ifndef JSON_POOL_SIZE
+  #ifdef ESP8266
+    #define JSON_POOL_SIZE 2
+  #else
+    #define JSON_POOL_SIZE 4  // must divide 256 (queue indices wrap)
+  #endif
+#endif
+#ifdef ESP8266
+  #define JSON_CMD_DOC_SIZE 2048
+#else
+  #define JSON_CMD_DOC_SIZE 6144
+#endif
+
+// Default limit for WebSocket messages arriving in several frames or packets
+#ifdef ESP8266
+  #define WS_MAX_MESSAGE_SIZE 4096
+#else
+  #define WS_MAX_MESSAGE_SIZE JSON_BUFFER_SIZE
+#endif
+
 //#define MIN_HEAP_SIZE (8k for AsyncWebServer)
 #define MIN_HEAP_SIZE 8192
 
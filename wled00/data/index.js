@@ -21,6 +21,7 @@ var plJson = {}; // array of playlists
 var pN = "", pI = 0, pNum = 0;
 var pmt = 1, pmtLS = 0, pmtLast = 0;
 var lastinfo = {};
+var lastState = null; // last full state received via WebSocket, base for state patches
 var isM = false, mw = 0, mh=0;
 var ws, cpick, ranges, wsRpt=0;
 var cfg = {
@@ -1320,6 +1321,11 @@ function makeWS() {
 		if (e.data instanceof ArrayBuffer) return; // liveview packet
 		var json = JSON.parse(e.data);
 		if (json.leds) return; // JSON liveview packet
+		if (json.sp) {
+			if (!lastState) return; // wait for next full state
+			json = {state: patchState(lastState, json.sp)};
+		}
+		if (json.state) lastState = json.state;
 		clearTimeout(jsonTimeout);
 		jsonTimeout = null;
 		lastUpdate = new Date();
@@ -1343,11 +1349,29 @@ function makeWS() {
 	}
 	ws.onopen = (e)=>{
 		//ws.send("{'v':true}"); // unnecessary (https://github.com/Aircoookie/WLED/blob/master/wled00/ws.cpp#L18)
+		ws.send('{"diff":true}'); // receive only changed state keys and segments
 		wsRpt = 0;
 		reqsLegal = true;
 	}
 }
 
+// applies WebSocket state patch: top level keys are replaced, segments by id ({"id":n,"stop":0} removes one)
+function patchState(s, p)
+{
+	let n = Object.assign({}, s, p);
+	if (p.seg) {
+		let seg = (s.seg||[]).slice();
+		for (let ps of p.seg) {
+			let i = seg.findIndex((e)=>e.id==ps.id);
+			if (ps.stop === 0 && Object.keys(ps).length == 2) { if (i >= 0) seg.splice(i, 1); }
+			else if (i >= 0) seg[i] = ps;
+			else seg.push(ps);
+		}
+		n.seg = seg.sort((a,b)=>a.id-b.id);
+	}
+	return n;
+}
+
 function readState(s,command=false)
 {
 	if (!s) return false;
@@ -8,6 +8,169 @@
  * E1.31 handler
  */
 
+/*
+ * Realtime frame assembly
+ * Once a sender marks frame ends (DDP push flag, E1.31 synchronization address, ArtSync) or sends
+ * more than one universe, its pixels are collected in a back buffer and copied to the strip at once:
+ * on DDP push, on E1.31/Art-Net sync packet, when all universes seen from the sender have arrived
+ * (its highest universe completing the frame), or when realtimeFrameTimeout expires. Other senders
+ * are shown as packets arrive, as without frame assembly.
+ */
+#define RT_FRAME_BPP REALTIME_PIXELS_RGBW // back buffer holds R,G,B,W bytes per LED
+
+static uint8_t  *rtFrame = nullptr;     // back buffer (gamma & offset are applied when presenting)
+static uint16_t  rtFrameLen = 0;
+static uint16_t  rtFrameDirtyStart = UINT16_MAX, rtFrameDirtyStop = 0;
+static bool      rtFrameSignalled = false; // sender marks frame ends (push/sync), frames are assembled
+static uint32_t  rtFrameUniverses = 0;  // bit mask of universes received for pending frame
+static uint32_t  rtSenderUniverses = 0; // bit mask of universes seen from current sender
+static uint8_t   rtSender[E131_CID_LEN] = {0};
+static unsigned long rtFrameStart = 0;  // arrival of first data of pending frame
+
+static uint8_t  *ddpJitterFrames = nullptr; // DDP jitter buffer frames (ddpJitter.getDepth() x ddpJitterLen)
+static uint16_t  ddpJitterLen = 0;
+static uint32_t  ddpTimecode = 0;
+static bool      ddpHasTimecode = false;
+
+// returns true if back buffer is used for the current frame
+static bool useRealtimeFrame() {
+  uint16_t len = strip.getLengthTotal();
+  bool multiUniverse = rtSenderUniverses & (rtSenderUniverses - 1);
+  if (!realtimeFrameTimeout || !(rtFrameSignalled || multiUniverse) || !len) {
+    free(rtFrame);
+    rtFrame = nullptr;
+    rtFrameLen = 0;
+    return false;
+  }
+  if (rtFrameLen != len) {
+    free(rtFrame);
+    rtFrame = (uint8_t*)calloc(len, RT_FRAME_BPP);
+    rtFrameLen = rtFrame ? len : 0;
+  } else if (!realtimeMode && rtFrame) {
+    memset(rtFrame, 0, len * RT_FRAME_BPP); // entering realtime mode clears the strip
+  }
+  return rtFrame != nullptr;
+}
+
+// write run of len pixels (REALTIME_PIXELS_* format) to back buffer or directly to the strip
+static void setRealtimeFramePixels(uint16_t start, uint16_t len, const uint8_t *data, uint8_t format) {
+  if (!rtFrame) { setRealtimePixels(start, len, data, format); return; }
+  if (start >= rtFrameLen) return;
+  if (len > rtFrameLen - start) len = rtFrameLen - start;
+  if (!len) return;
+  uint8_t *dst = rtFrame + start * RT_FRAME_BPP;
+  if (format == RT_FRAME_BPP) {
+    memcpy(dst, data, len * RT_FRAME_BPP);
+  } else {
+    for (uint16_t i = 0; i < len; i++, dst += RT_FRAME_BPP, data += format) {
+      dst[0] = data[0]; dst[1] = data[1]; dst[2] = data[2]; dst[3] = 0;
+    }
+  }
+  if (rtFrameDirtyStart > rtFrameDirtyStop) rtFrameStart = millis(); // first pixel of new frame
+  if (start < rtFrameDirtyStart) rtFrameDirtyStart = start;
+  if (start + len > rtFrameDirtyStop) rtFrameDirtyStop = start + len;
+}
+
+static void freeDDPJitterFrames() {
+  free(ddpJitterFrames);
+  ddpJitterFrames = nullptr;
+  ddpJitter.reset(0);
+}
+
+// queue assembled DDP frame in jitter buffer, returns false if it has to be presented immediately
+static bool queueDDPFrame() {
+  if (!rtFrame || !ddpJitterDepth) {
+    if (ddpJitterFrames) freeDDPJitterFrames();
+    return false;
+  }
+  if (!ddpJitterFrames || ddpJitter.getDepth() != ddpJitterDepth || ddpJitterLen != rtFrameLen) {
+    free(ddpJitterFrames);
+    ddpJitterFrames = (uint8_t*)malloc(ddpJitterDepth * rtFrameLen * RT_FRAME_BPP);
+    if (!ddpJitterFrames) { ddpJitter.reset(0); return false; }
+    ddpJitterLen = rtFrameLen;
+    ddpJitter.reset(ddpJitterDepth);
+  }
+  int8_t slot = ddpJitter.push(JitterBuffer::timecodeToMs(ddpTimecode), ddpHasTimecode, millis());
+  if (slot < 0) return false;
+  memcpy(ddpJitterFrames + slot * rtFrameLen * RT_FRAME_BPP, rtFrame, rtFrameLen * RT_FRAME_BPP);
+  rtFrameDirtyStart = UINT16_MAX;
+  rtFrameDirtyStop = 0;
+  return true;
+}
+
+// copy pending back buffer pixels to the strip and show them
+void presentRealtimeFrame() {
+  if (rtFrame && rtFrameDirtyStart < rtFrameDirtyStop) {
+    setRealtimePixels(rtFrameDirtyStart, rtFrameDirtyStop - rtFrameDirtyStart, rtFrame + rtFrameDirtyStart * RT_FRAME_BPP, RT_FRAME_BPP);
+    e131NewData = true;
+  }
+  rtFrameDirtyStart = UINT16_MAX;
+  rtFrameDirtyStop = 0;
+  rtFrameUniverses = 0;
+}
+
+// present incomplete frames after timeout, release back buffer once realtime mode ended
+void handleRealtimeFrame() {
+  if (!rtFrame) return;
+  if (!realtimeMode) {
+    rtFrameSignalled = false;
+    rtSenderUniverses = 0;
+    free(rtFrame);
+    rtFrame = nullptr;
+    rtFrameLen = 0;
+    freeDDPJitterFrames();
+    presentRealtimeFrame(); // reset state
+    return;
+  }
+  if (ddpJitterFrames) {
+    int8_t slot = ddpJitter.pop(millis());
+    if (slot >= 0) {
+      setRealtimePixels(0, ddpJitterLen, ddpJitterFrames + slot * ddpJitterLen * RT_FRAME_BPP, RT_FRAME_BPP);
+      e131NewData = true;
+    }
+  }
+  if (rtFrameDirtyStart < rtFrameDirtyStop && millis() - rtFrameStart > realtimeFrameTimeout) {
+    rtFrameSignalled = false; // push/sync stopped arriving, show packets as they arrive again
+    presentRealtimeFrame();
+  }
+}
+
+// learns the universes of the current E1.31/Art-Net sender, returns true if universe completes its frame
+// (all seen universes arrived, ending with the highest: senders send universes in ascending order)
+static bool trackRealtimeUniverse(const uint8_t *cid, uint8_t universe) {
+  const uint32_t bit = 1UL << universe;
+  if (memcmp(cid, rtSender, E131_CID_LEN)) { // another sender took over
+    memcpy(rtSender, cid, E131_CID_LEN);
+    rtSenderUniverses = rtFrameUniverses = 0;
+  }
+  if ((rtFrameUniverses & bit) || (rtFrameUniverses && bit <= (rtSenderUniverses & -rtSenderUniverses))) {
+    // next frame started before the pending one completed: sender covers fewer universes now (or lost one)
+    rtSenderUniverses = rtFrameUniverses;
+    presentRealtimeFrame();
+  }
+  rtFrameUniverses  |= bit;
+  rtSenderUniverses |= bit;
+  return (rtSenderUniverses & (rtSenderUniverses - 1)) && rtSenderUniverses < (bit << 1) && rtFrameUniverses == rtSenderUniverses;
+}
+
+// number of universes needed to cover the whole strip in DMX_MODE_MULTIPLE_* modes
+static uint8_t getMultipleUniverseCount() {
+  bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
+  const uint16_t dmxChannelsPerLed = is4Chan ? 4 : 3;
+  const uint16_t dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
+  const uint16_t dmxLenOffset = (DMXAddress == 0) ? 0 : 1; // For legacy DMX start address 0
+  const uint16_t ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
+  const uint16_t totalLen = strip.getLengthTotal();
+  uint16_t universes = 1;
+
+  if (totalLen > ledsInFirstUniverse) {
+    const uint16_t ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
+    const uint16_t remainLED = totalLen - ledsInFirstUniverse;
+    universes += (remainLED + ledsPerUniverse - 1) / ledsPerUniverse;
+  }
+  return min(universes, (uint16_t)E131_MAX_UNIVERSE_COUNT);
+}
+
 //DDP protocol support, called by handleE131Packet
 //handles RGB data only
 void handleDDPPacket(e131_packet_t* p) {
@@ -32,20 +195,26 @@ void handleDDPPacket(e131_packet_t* p) {
   uint16_t stop = start + htons(p->dataLen) / ddpChannelsPerLed;
   uint8_t* data = p->data;
   uint16_t c = 0;
-  if (p->flags & DDP_TIMECODE_FLAG) c = 4; //packet has timecode flag, we do not support it, but data starts 4 bytes later
+  ddpHasTimecode = p->flags & DDP_TIMECODE_FLAG;
+  if (ddpHasTimecode) {
+    ddpTimecode = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+    c = 4; //packet has timecode, data starts 4 bytes later
+  }
 
+  useRealtimeFrame();
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
 
-  if (!realtimeOverride || (realtimeMode && useMainSegmentOnly)) {
-    for (uint16_t i = start; i < stop; i++) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
-      c += ddpChannelsPerLed;
-    }
+  if ((!realtimeOverride || (realtimeMode && useMainSegmentOnly)) && start < stop) {
+    setRealtimeFramePixels(start, stop - start, data + c, ddpChannelsPerLed);
   }
 
   bool push = p->flags & DDP_PUSH_FLAG;
   if (push) {
-    e131NewData = true;
+    rtFrameSignalled = true; // assemble following frames
+    if (!queueDDPFrame()) {
+      presentRealtimeFrame();
+      e131NewData = true;
+    }
     byte sn = p->sequenceNum & 0xF;
     if (sn) e131LastSequenceNumber[0] = sn;
   }
@@ -57,6 +226,10 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
   uint16_t uni = 0, dmxChannels = 0;
   uint8_t* e131_data = nullptr;
   uint8_t seq = 0, mde = REALTIME_MODE_E131;
+  uint8_t cid[E131_CID_LEN] = {0};
+  uint8_t priority = 100; // E1.31 default, Art-Net has none
+  bool terminated = false;
+  bool syncAddress = false; // E1.31 sender will send sync packets
 
   if (protocol == P_ARTNET)
   {
@@ -64,12 +237,23 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      rtFrameSignalled = true; // sender syncs, from now on wait for ArtSync before presenting
+      presentRealtimeFrame();
+      return;
+    }
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
     e131_data = p->art_data;
     seq = p->art_sequence_number;
     mde = REALTIME_MODE_ARTNET;
+    for (size_t x = 0; x < 4; x++) cid[x] = clientIP[x]; // Art-Net sources are told apart by IP
   } else if (protocol == P_E131) {
+    if (htonl(p->root_vector) == 0x00000008) { // synchronization packet
+      rtFrameSignalled = true;
+      presentRealtimeFrame();
+      return;
+    }
     // Ignore PREVIEW data (E1.31: 6.2.6)
     if ((p->options & 0x80) != 0) return;
     dmxChannels = htons(p->property_value_count) - 1;
@@ -78,12 +262,11 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
     uni = htons(p->universe);
     e131_data = p->property_values;
     seq = p->sequence_number;
-    if (e131Priority != 0) {
-      if (p->priority < e131Priority ) return;
-      // track highest priority & skip all lower priorities
-      if (p->priority >= highPriority.get()) highPriority.set(p->priority);
-      if (p->priority < highPriority.get()) return;
-    }
+    syncAddress = p->reserved != 0;
+    if (p->priority < e131Priority) return;
+    memcpy(cid, p->cid, E131_CID_LEN);
+    priority = p->priority;
+    terminated = p->options & 0x40; // stream terminated, source stops sending (E1.31: 6.2.6)
   } else { //DDP
     realtimeIP = clientIP;
     handleDDPPacket(p);
@@ -104,18 +287,31 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
 
   uint8_t previousUniverses = uni - e131Universe;
 
-  if (e131SkipOutOfSequence)
-    if (seq < e131LastSequenceNumber[previousUniverses] && seq > 20 && e131LastSequenceNumber[previousUniverses] < 250){
-      DEBUG_PRINT(F("skipping E1.31 frame (last seq="));
-      DEBUG_PRINT(e131LastSequenceNumber[previousUniverses]);
-      DEBUG_PRINT(F(", current seq="));
-      DEBUG_PRINT(seq);
-      DEBUG_PRINT(F(", universe="));
-      DEBUG_PRINT(uni);
-      DEBUG_PRINTLN(")");
-      return;
-    }
-  e131LastSequenceNumber[previousUniverses] = seq;
+  // arbitrate between sources of this universe, merge equal priority sources
+  e131Merge.setMode(e131MergeMode);
+  e131Merge.setTimeout(e131SourceTimeout);
+  if (terminated) {
+    e131Merge.terminate(previousUniverses, cid);
+    return;
+  }
+  const uint16_t startCode = (protocol == P_E131) ? 1 : 0; // E1.31 data includes DMX start code
+  uint16_t mergedLen = dmxChannels + startCode;
+  e131_data = e131Merge.merge(previousUniverses, cid, priority, seq, e131SkipOutOfSequence, e131_data, mergedLen, millis());
+  if (!e131_data) {
+    DEBUG_PRINT(F("skipping E1.31 packet (lower priority or out of sequence, universe="));
+    DEBUG_PRINT(uni);
+    DEBUG_PRINTLN(")");
+    return;
+  }
+  dmxChannels = mergedLen - startCode;
+
+  // only a source that won arbitration switches assembly on sync packets on or off
+  if (syncAddress) {
+    rtFrameSignalled = true;
+  } else if (protocol == P_E131 && rtFrameSignalled) {
+    presentRealtimeFrame(); // sender stopped syncing
+    rtFrameSignalled = false;
+  }
 
   // update status info
   realtimeIP = clientIP;
@@ -294,6 +490,8 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
           return;
         }
 
+        bool complete = trackRealtimeUniverse(cid, previousUniverses); // may present the previous frame
+        bool assemble = useRealtimeFrame();
         realtimeLock(realtimeTimeoutMs, mde);
         if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
 
@@ -308,16 +506,13 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
           }
         }
 
-        if (!is4Chan) {
-          for (uint16_t i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], 0);
-            dmxOffset+=3;
-          }
-        } else {
-          for (uint16_t i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], e131_data[dmxOffset+3]);
-            dmxOffset+=4;
-          }
+        if (ledsTotal > previousLeds) {
+          setRealtimeFramePixels(previousLeds, ledsTotal - previousLeds, &e131_data[dmxOffset], is4Chan ? REALTIME_PIXELS_RGBW : REALTIME_PIXELS_RGB);
+        }
+
+        if (assemble) {
+          if (complete && !rtFrameSignalled) presentRealtimeFrame(); // otherwise presented on sync packet
+          return;
         }
         break;
       }
@@ -354,30 +549,8 @@ void handleArtnetPollReply(IPAddress ipAddress) {
     case DMX_MODE_MULTIPLE_DRGB:
     case DMX_MODE_MULTIPLE_RGB:
     case DMX_MODE_MULTIPLE_RGBW:
-      {
-        bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
-        const uint16_t dmxChannelsPerLed = is4Chan ? 4 : 3;
-        const uint16_t dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
-        const uint16_t dmxLenOffset = (DMXAddress == 0) ? 0 : 1; // For legacy DMX start address 0
-        const uint16_t ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
-        const uint16_t totalLen = strip.getLengthTotal();
-
-        if (totalLen > ledsInFirstUniverse) {
-          const uint16_t ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
-          const uint16_t remainLED = totalLen - ledsInFirstUniverse;
-
-          endUniverse += (remainLED / ledsPerUniverse);
-
-          if ((remainLED % ledsPerUniverse) > 0) {
-            endUniverse++;
-          }
-
-          if ((endUniverse - startUniverse) > E131_MAX_UNIVERSE_COUNT) {
-            endUniverse = startUniverse + E131_MAX_UNIVERSE_COUNT - 1;
-          }
-        }
-        break;
-      }
+      endUniverse += getMultipleUniverseCount() - 1;
+      break;
     default:
       DEBUG_PRINTLN(F("unknown E1.31 DMX mode"));
       return;  // nothing to do
@@ -526,4 +699,114 @@ void sendArtnetPollReply(ArtPollReply *reply, IPAddress ipAddress, uint16_t port
   notifierUdp.endPacket();
 
   reply->reply_bind_index++;
-}
\ No newline at end of file
+}
+/*
+ * E1.31/Art-Net/DDP ingest queue
+ * On ESP32 AsyncUDP callbacks run in the network task. Packets are copied into a single producer/
+ * single consumer ring buffer there and handled from the main loop (handleE131Ingest()), so they
+ * don't race with strip.service(). ESP8266 callbacks are handled directly.
+ */
+#ifdef ARDUINO_ARCH_ESP32
+#define E131_INGEST_SIZE  16384  // ring buffer size in bytes (holds ~24 full universes)
+#define E131_INGEST_WRAP  0xFFFF // entry length marking that the next entry starts at offset 0
+
+typedef struct IngestHeader {
+  uint16_t len;       // packet length, or E131_INGEST_WRAP
+  uint8_t  protocol;
+  uint8_t  reserved;
+  uint8_t  ip[4];
+} IngestHeader;       // 8 bytes, keeps packets 4 byte aligned
+
+static uint8_t           *e131Ingest = nullptr;
+static volatile uint16_t  e131IngestHead = 0;      // written by network task only
+static volatile uint16_t  e131IngestTail = 0;      // written by main loop only
+static volatile uint32_t  e131IngestQueued = 0, e131IngestHandled = 0;
+#endif
+
+// packet length from protocol headers, 0 if the headers claim more data than the UDP packet holds
+static size_t getE131PacketLength(e131_packet_t *p, byte protocol, size_t udpLen) {
+  size_t len;
+  switch (protocol) {
+    case P_ARTNET: len = (p->art_opcode == ARTNET_OPCODE_OPDMX) ? 18 + htons(p->art_length) : 14; break;
+    case P_E131:   len = 16 + (htons(p->root_flength) & 0x0FFF); break; // root layer length counts from offset 16
+    default:       len = 10 + ((p->flags & DDP_TIMECODE_FLAG) ? 4 : 0) + htons(p->dataLen); break; // DDP
+  }
+  if (len > udpLen) return 0;
+  return min(len, sizeof(e131_packet_t));
+}
+
+void queueE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_t udpLen) {
+  const size_t len = getE131PacketLength(p, protocol, udpLen);
+  if (!len) return; // truncated or malformed, handlers would read past the packet
+#ifdef ARDUINO_ARCH_ESP32
+  if (!e131Ingest) { e131IngestDrops++; return; } // allocated by main loop
+  const size_t need = sizeof(IngestHeader) + ((len + 3) & ~3);
+  uint16_t head = e131IngestHead;
+  uint16_t tail = e131IngestTail;
+
+  if (head >= tail) {
+    // free space is [head, end) and [0, tail - 1), ring must never become completely full (head == tail means empty)
+    if (E131_INGEST_SIZE - head < need + (tail == 0)) {
+      if (tail <= need) { e131IngestDrops++; return; }
+      ((IngestHeader*)(e131Ingest + head))->len = E131_INGEST_WRAP;
+      head = 0;
+    }
+  } else if (tail - head <= need) {
+    e131IngestDrops++;
+    return;
+  }
+
+  IngestHeader *h = (IngestHeader*)(e131Ingest + head);
+  h->len = len;
+  h->protocol = protocol;
+  for (uint8_t i = 0; i < 4; i++) h->ip[i] = clientIP[i];
+  memcpy(e131Ingest + head + sizeof(IngestHeader), p, len);
+  head += need;
+  if (head >= E131_INGEST_SIZE) head = 0;
+  __sync_synchronize(); // publish data before head
+  e131IngestHead = head;
+  uint16_t depth = ++e131IngestQueued - e131IngestHandled;
+  if (depth > e131IngestPeak) e131IngestPeak = depth;
+#else
+  handleE131Packet(p, clientIP, protocol);
+#endif
+}
+
+// handle queued packets (ESP32), bounded by time so the strip keeps being serviced
+void handleE131Ingest() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (!e131Ingest) {
+    if (!(e131Ingest = (uint8_t*)malloc(E131_INGEST_SIZE))) return;
+    e131IngestHead = e131IngestTail = 0;
+  }
+  unsigned long start = micros();
+  uint16_t tail = e131IngestTail;
+  while (tail != e131IngestHead) {
+    __sync_synchronize(); // see data published with head
+    IngestHeader *h = (IngestHeader*)(e131Ingest + tail);
+    if (h->len == E131_INGEST_WRAP) {
+      tail = 0;
+      e131IngestTail = tail;
+      continue;
+    }
+    handleE131Packet((e131_packet_t*)(e131Ingest + tail + sizeof(IngestHeader)), IPAddress(h->ip[0], h->ip[1], h->ip[2], h->ip[3]), h->protocol);
+    tail += sizeof(IngestHeader) + ((h->len + 3) & ~3);
+    if (tail >= E131_INGEST_SIZE) tail = 0;
+    __sync_synchronize(); // done reading before releasing space
+    e131IngestTail = tail;
+    e131IngestHandled++;
+    if (micros() - start > 5000) {
+      udpIngestDeferred++;
+      break;
+    }
+  }
+#endif
+}
+
+uint16_t getE131IngestDepth() {
+#ifdef ARDUINO_ARCH_ESP32
+  return e131IngestQueued - e131IngestHandled;
+#else
+  return 0;
+#endif
+}
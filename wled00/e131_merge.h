@@ -0,0 +1,170 @@
+#ifndef WLED_E131_MERGE_H
+#define WLED_E131_MERGE_H
+
+/*
+ * Multi-source E1.31 / Art-Net merging
+ *
+ * Sources are tracked per universe by CID (Art-Net has none, its source IP is used instead).
+ * Only sources with the highest priority heard within the source timeout are used, so a backup
+ * console takes over as soon as the main one falls silent. Sources of equal priority either take
+ * turns (LTP, latest packet wins) or are combined channel by channel (HTP, highest value wins),
+ * for HTP the last data of each source is kept.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef E131_MERGE_UNIVERSES
+  #ifdef E131_MAX_UNIVERSE_COUNT
+    #define E131_MERGE_UNIVERSES E131_MAX_UNIVERSE_COUNT
+  #else
+    #define E131_MERGE_UNIVERSES 9
+  #endif
+#endif
+#ifndef E131_MERGE_SOURCES
+  #ifdef ESP8266
+    #define E131_MERGE_SOURCES 2
+  #else
+    #define E131_MERGE_SOURCES 4
+  #endif
+#endif
+
+#define E131_MERGE_LTP      0
+#define E131_MERGE_HTP      1
+#define E131_MERGE_DATA_LEN 513 // start code (E1.31) + 512 channels
+#define E131_CID_LEN        16
+
+class E131Merge {
+  public:
+    E131Merge() : _sources(nullptr), _out(nullptr), _timeout(2500), _mode(E131_MERGE_LTP) {}
+
+    void setMode(uint8_t mode) {
+      if (mode == _mode) return;
+      reset(); // HTP data was not kept in LTP mode
+      _mode = mode;
+    }
+    void setTimeout(uint16_t ms) { _timeout = ms ? ms : 1; }
+
+    void reset() {
+      if (_sources) for (size_t i = 0; i < E131_MERGE_UNIVERSES * E131_MERGE_SOURCES; i++) release(&_sources[i]);
+      free(_sources);
+      free(_out);
+      _sources = nullptr;
+      _out = nullptr;
+    }
+
+    // returns data to be used for universe slot uni (packet data or merged data) or nullptr if the packet is to be ignored
+    // len is the data length on entry and the length of the returned data on exit
+    uint8_t* merge(uint8_t uni, const uint8_t *cid, uint8_t priority, uint8_t seq, bool checkSeq, uint8_t *data, uint16_t &len, uint32_t now) {
+      if (uni >= E131_MERGE_UNIVERSES) return data;
+      if (!_sources) {
+        _sources = (Source*)calloc(E131_MERGE_UNIVERSES * E131_MERGE_SOURCES, sizeof(Source));
+        if (!_sources) return data; // no arbitration without memory
+      }
+      Source *u = &_sources[uni * E131_MERGE_SOURCES];
+      for (size_t i = 0; i < E131_MERGE_SOURCES; i++) {
+        if (u[i].active && now - u[i].lastSeen > _timeout) release(&u[i]); // source lost
+      }
+
+      Source *src = find(u, cid);
+      if (!src) {
+        src = allocate(u, priority);
+        if (!src) return nullptr; // table full of sources with at least the same priority
+        memcpy(src->cid, cid, E131_CID_LEN);
+        src->active = true;
+      } else if (checkSeq && seq) {
+        int8_t diff = seq - src->seq;
+        if (diff <= 0 && diff > -20) return nullptr; // late or duplicate packet (E1.31 6.7.2)
+      }
+      src->seq = seq;
+      src->priority = priority;
+      src->lastSeen = now;
+
+      uint8_t top = 0, count = 0;
+      for (size_t i = 0; i < E131_MERGE_SOURCES; i++) {
+        if (!u[i].active) continue;
+        if (u[i].priority > top) { top = u[i].priority; count = 1; }
+        else if (u[i].priority == top) count++;
+      }
+      if (priority < top) return nullptr;
+      if (_mode != E131_MERGE_HTP) return data; // LTP
+
+      if (len > E131_MERGE_DATA_LEN) len = E131_MERGE_DATA_LEN;
+      if (!src->data) src->data = (uint8_t*)malloc(E131_MERGE_DATA_LEN);
+      if (src->data) {
+        memcpy(src->data, data, len);
+        src->len = len;
+      }
+      if (count < 2) return data;
+      if (!_out) _out = (uint8_t*)malloc(E131_MERGE_DATA_LEN);
+      if (!_out) return data;
+
+      uint16_t outLen = 0;
+      memset(_out, 0, E131_MERGE_DATA_LEN);
+      for (size_t i = 0; i < E131_MERGE_SOURCES; i++) {
+        if (!u[i].active || u[i].priority != top || !u[i].data) continue;
+        for (size_t c = 0; c < u[i].len; c++) if (u[i].data[c] > _out[c]) _out[c] = u[i].data[c];
+        if (u[i].len > outLen) outLen = u[i].len;
+      }
+      len = outLen;
+      return _out;
+    }
+
+    // source announced it stops sending (E1.31 stream terminated option)
+    void terminate(uint8_t uni, const uint8_t *cid) {
+      if (!_sources || uni >= E131_MERGE_UNIVERSES) return;
+      Source *src = find(&_sources[uni * E131_MERGE_SOURCES], cid);
+      if (src) release(src);
+    }
+
+    // number of sources currently sending to universe slot uni
+    uint8_t getSourceCount(uint8_t uni) const {
+      uint8_t count = 0;
+      if (!_sources || uni >= E131_MERGE_UNIVERSES) return 0;
+      for (size_t i = 0; i < E131_MERGE_SOURCES; i++) if (_sources[uni * E131_MERGE_SOURCES + i].active) count++;
+      return count;
+    }
+
+  private:
+    struct Source {
+      uint8_t  cid[E131_CID_LEN];
+      uint32_t lastSeen;
+      uint8_t *data;       // last data for HTP merge
+      uint16_t len;
+      uint8_t  priority;
+      uint8_t  seq;
+      bool     active;
+    };
+
+    Source* find(Source *u, const uint8_t *cid) {
+      for (size_t i = 0; i < E131_MERGE_SOURCES; i++) {
+        if (u[i].active && !memcmp(u[i].cid, cid, E131_CID_LEN)) return &u[i];
+      }
+      return nullptr;
+    }
+
+    // free slot, or slot of a source with lower priority that is dropped for the new one
+    Source* allocate(Source *u, uint8_t priority) {
+      Source *lowest = nullptr;
+      for (size_t i = 0; i < E131_MERGE_SOURCES; i++) {
+        if (!u[i].active) return &u[i];
+        if (!lowest || u[i].priority < lowest->priority) lowest = &u[i];
+      }
+      if (lowest->priority >= priority) return nullptr;
+      release(lowest);
+      return lowest;
+    }
+
+    void release(Source *src) {
+      free(src->data);
+      memset(src, 0, sizeof(Source));
+    }
+
+    Source  *_sources;     // E131_MERGE_SOURCES per universe, allocated with first packet
+    uint8_t *_out;         // merged data
+    uint16_t _timeout;     // ms until a silent source is dropped
+    uint8_t  _mode;
+};
+
+#endif
@@ -82,6 +82,11 @@ void handleDMX();
 
 //e131.cpp
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol);
+void queueE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_t udpLen);
+void handleE131Ingest();
+uint16_t getE131IngestDepth();
+void presentRealtimeFrame();
+void handleRealtimeFrame();
 void handleArtnetPollReply(IPAddress ipAddress);
 void prepareArtnetPollReply(ArtPollReply* reply);
 void sendArtnetPollReply(ArtPollReply* reply, IPAddress ipAddress, uint16_t portAddress);
@@ -147,9 +152,10 @@ bool deserializeState(JsonObject root, byte callMode = CALL_MODE_DIRECT_CHANGE,
 void serializeSegment(JsonObject& root, Segment& seg, byte id, bool forPreset = false, bool segmentBounds = true);
 void serializeState(JsonObject root, bool forPreset = false, bool includeBri = true, bool segmentBounds = true, bool selectedSegmentsOnly = false);
 void serializeInfo(JsonObject root);
-void serializeModeNames(JsonArray root);
-void serializeModeData(JsonArray root);
 void serveJson(AsyncWebServerRequest* request);
+void serveNodesBinary(AsyncWebServerRequest* request);
+void handleJsonCache();
+void invalidateJsonCache();
 #ifdef WLED_ENABLE_JSONLIVE
 bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient = 0);
 #endif
@@ -199,6 +205,12 @@ void handleOverlayDraw();
 void _overlayAnalogCountdown();
 void _overlayAnalogClock();
 
+//pixels.cpp
+bool applyPixelData(const uint8_t *data, size_t len);
+bool applyPixelFrame(const char *name);
+void handlePixelUploadBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total);
+void servePixelUpload(AsyncWebServerRequest *request);
+
 //playlist.cpp
 void shufflePlaylist();
 void unloadPlaylist();
@@ -228,10 +240,14 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply=tru
 //udp.cpp
 void notify(byte callMode, bool followUp=false);
 uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8_t *buffer, uint8_t bri=255, bool isRGBW=false);
+bool queueRealtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8_t *buffer, uint8_t bri=255, bool isRGBW=false);
+void handleNetworkOutput();
+uint8_t getNetworkOutputQueueDepth();
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void setRealtimePixels(uint16_t start, uint16_t len, const uint8_t *data, uint8_t format = REALTIME_PIXELS_RGB);
 void refreshNodeList();
 void sendSysInfoUDP();
 
@@ -346,6 +362,12 @@ void prepareHostname(char* hostname);
 bool isAsterisksOnly(const char* str, byte maxLen);
 bool requestJSONBufferLock(uint8_t module=255);
 void releaseJSONBufferLock();
+JsonDocument* parseJsonCommand(const char *json, size_t len);
+void releaseJsonCommand(JsonDocument *cmd);
+void queueJsonCommand(JsonDocument *cmd);
+bool applyJsonCommand(JsonDocument *cmd);
+bool flushJsonQueue();
+void handleJsonQueue();
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen);
 uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxLen, uint8_t *var = nullptr);
 int16_t extractModeDefaults(uint8_t mode, const char *segVar);
@@ -409,6 +431,11 @@ void sendDataWs(AsyncWebSocketClient * client = nullptr);
 //xml.cpp
 void XML_response(AsyncWebServerRequest *request, char* dest = nullptr);
 void URL_response(AsyncWebServerRequest *request);
-void getSettingsJS(byte subPage, char* dest);
+struct SettingsLiveValues { // values changing while the settings page is served, taken once per request
+  uint16_t milliamps;
+  byte     hueError;
+};
+SettingsLiveValues getSettingsLiveValues();
+void getSettingsJS(byte subPage, char* dest, const SettingsLiveValues &live);
 
 #endif
@@ -0,0 +1,183 @@
+#ifndef WLED_GZIP_WRITER_H
+#define WLED_GZIP_WRITER_H
+
+/*
+ * Minimal gzip compressor (RFC 1951 fixed Huffman blocks, RFC 1952 framing)
+ *
+ * Input is compressed in blocks of GZIP_BLOCK_SIZE bytes with greedy LZ77 matching inside each block,
+ * so memory use stays small (block + hash table) at the cost of some compression ratio. Good enough for
+ * repetitive JSON like effect metadata. Output is handed to a callback.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef GZIP_BLOCK_SIZE
+  #ifdef ESP8266
+    #define GZIP_BLOCK_SIZE 2048
+  #else
+    #define GZIP_BLOCK_SIZE 4096
+  #endif
+#endif
+#define GZIP_HASH_BITS 10
+
+class GzipWriter {
+  public:
+    typedef bool (*Sink)(const uint8_t *data, size_t len, void *ctx);
+
+    static uint32_t crc32(uint32_t crc, const uint8_t *data, size_t len) {
+      static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+      };
+      crc = ~crc;
+      for (size_t i = 0; i < len; i++) {
+        crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+      }
+      return ~crc;
+    }
+
+    GzipWriter(Sink sink, void *ctx) : _sink(sink), _ctx(ctx), _crc(0), _size(0), _blockLen(0), _bits(0), _bitCount(0), _outLen(0), _ok(true) {
+      _block = (uint8_t*)malloc(GZIP_BLOCK_SIZE);
+      _head  = (int16_t*)malloc(sizeof(int16_t) << GZIP_HASH_BITS);
+      if (!_block || !_head) { _ok = false; return; }
+      static const uint8_t header[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF}; // deflate, no name, no mtime, unknown OS
+      for (size_t i = 0; i < sizeof(header); i++) putByte(header[i]);
+    }
+    ~GzipWriter() { free(_block); free(_head); }
+
+    bool write(const uint8_t *data, size_t len) {
+      if (!_ok) return false;
+      _crc = crc32(_crc, data, len);
+      _size += len;
+      while (len) {
+        size_t n = GZIP_BLOCK_SIZE - _blockLen;
+        if (n > len) n = len;
+        memcpy(_block + _blockLen, data, n);
+        _blockLen += n;
+        data += n;
+        len -= n;
+        if (_blockLen == GZIP_BLOCK_SIZE) compressBlock(false);
+      }
+      return _ok;
+    }
+
+    // writes last block and trailer, returns false if the sink failed or memory was missing
+    bool finish() {
+      if (!_ok) return false;
+      compressBlock(true);
+      if (_bitCount) putByte(_bits); // pad last byte
+      _bits = _bitCount = 0;
+      for (int i = 0; i < 4; i++) putByte(_crc >> (8*i));
+      for (int i = 0; i < 4; i++) putByte(_size >> (8*i));
+      flush();
+      return _ok;
+    }
+
+    uint32_t getCrc()  const { return _crc; }  // of uncompressed data
+    uint32_t getSize() const { return _size; }
+
+  private:
+    void compressBlock(bool last) {
+      putBits(last ? 1 : 0, 1); // BFINAL
+      putBits(1, 2);            // BTYPE fixed Huffman
+      memset(_head, 0xFF, sizeof(int16_t) << GZIP_HASH_BITS); // -1: no previous occurrence
+      size_t i = 0;
+      while (i < _blockLen) {
+        size_t bestLen = 0, bestDist = 0;
+        if (i + 2 < _blockLen) {
+          uint16_t h = hash(_block + i);
+          int16_t cand = _head[h];
+          _head[h] = i;
+          if (cand >= 0) {
+            size_t max = _blockLen - i;
+            if (max > 258) max = 258;
+            size_t len = 0;
+            while (len < max && _block[cand + len] == _block[i + len]) len++;
+            if (len >= 3) { bestLen = len; bestDist = i - cand; }
+          }
+        }
+        if (!bestLen) {
+          putLiteral(_block[i++]);
+          continue;
+        }
+        putMatch(bestLen, bestDist);
+        for (size_t j = 1; j < bestLen && i + j + 2 < _blockLen; j++) _head[hash(_block + i + j)] = i + j; // index skipped positions
+        i += bestLen;
+      }
+      putSymbol(256); // end of block
+      _blockLen = 0;
+    }
+
+    static uint16_t hash(const uint8_t *p) {
+      return ((p[0] << 6) ^ (p[1] << 3) ^ p[2]) & ((1 << GZIP_HASH_BITS) - 1);
+    }
+
+    void putLiteral(uint8_t c) { putSymbol(c); }
+
+    void putMatch(size_t len, size_t dist) {
+      static const uint16_t lenBase[29]  = {3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258};
+      static const uint8_t  lenExtra[29] = {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0};
+      static const uint16_t distBase[30] = {1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577};
+      static const uint8_t  distExtra[30]= {0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
+      int l = 28;
+      while (lenBase[l] > len) l--;
+      putSymbol(257 + l);
+      putBits(len - lenBase[l], lenExtra[l]);
+      int d = 29;
+      while (distBase[d] > dist) d--;
+      putBits(reverse(d, 5), 5);
+      putBits(dist - distBase[d], distExtra[d]);
+    }
+
+    // fixed Huffman code of literal/length symbol (codes are sent most significant bit first)
+    void putSymbol(uint16_t sym) {
+      if      (sym < 144) putBits(reverse(0x30  + sym,         8), 8);
+      else if (sym < 256) putBits(reverse(0x190 + (sym - 144), 9), 9);
+      else if (sym < 280) putBits(reverse(sym - 256,           7), 7);
+      else                putBits(reverse(0xC0  + (sym - 280), 8), 8);
+    }
+
+    static uint16_t reverse(uint16_t code, uint8_t bits) {
+      uint16_t r = 0;
+      for (uint8_t i = 0; i < bits; i++) { r = (r << 1) | (code & 1); code >>= 1; }
+      return r;
+    }
+
+    void putBits(uint32_t value, uint8_t count) {
+      _bits |= value << _bitCount;
+      _bitCount += count;
+      while (_bitCount >= 8) {
+        putByte(_bits);
+        _bits >>= 8;
+        _bitCount -= 8;
+      }
+    }
+
+    void putByte(uint8_t b) {
+      _out[_outLen++] = b;
+      if (_outLen == sizeof(_out)) flush();
+    }
+
+    void flush() {
+      if (_outLen && _ok) _ok = _sink(_out, _outLen, _ctx);
+      _outLen = 0;
+    }
+
+    Sink     _sink;
+    void    *_ctx;
+    uint8_t *_block;    // input of current block
+    int16_t *_head;     // last position of each 3 byte hash in block
+    uint32_t _crc;
+    uint32_t _size;
+    size_t   _blockLen;
+    uint32_t _bits;     // pending output bits
+    uint8_t  _bitCount;
+    uint8_t  _out[64];
+    size_t   _outLen;
+    bool     _ok;
+};
+
+#endif
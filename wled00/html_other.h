@@ -255,63 +255,108 @@ const uint8_t PAGE_liveview[] PROGMEM = {
 
 
 // Autogenerated from wled00/data/liveviewws2D.htm, do not edit!!
-const uint16_t PAGE_liveviewws2D_length = 870;
+const uint16_t PAGE_liveviewws2D_length = 1600;
 const uint8_t PAGE_liveviewws2D[] PROGMEM = {
-  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x0a, 0x6d, 0x54, 0x6d, 0x6f, 0xdb, 0x36,
-  0x10, 0xfe, 0xee, 0x5f, 0xa1, 0x70, 0x43, 0x2a, 0xc6, 0xb2, 0x64, 0xbb, 0xed, 0x96, 0xc5, 0xa2,
-  0x87, 0x35, 0x0d, 0xb0, 0x02, 0xd9, 0x6a, 0x20, 0x19, 0x82, 0x21, 0x30, 0x50, 0x5a, 0x3a, 0x5b,
-  0x5c, 0x25, 0xd2, 0x20, 0xcf, 0x96, 0x35, 0x47, 0xff, 0x7d, 0x47, 0xc9, 0xc9, 0x32, 0x74, 0xfe,
-  0x20, 0x93, 0xf7, 0xf2, 0xdc, 0xdb, 0x73, 0x4c, 0xcf, 0x3e, 0x7e, 0xbe, 0xbe, 0xff, 0x73, 0x71,
-  0x13, 0x14, 0x58, 0x95, 0xf3, 0xf4, 0xf4, 0x05, 0x99, 0xcf, 0xd3, 0x0a, 0x50, 0x06, 0x5a, 0x56,
-  0x20, 0xd8, 0x5e, 0x41, 0xbd, 0x35, 0x16, 0x59, 0x30, 0xc8, 0x8c, 0x46, 0xd0, 0x28, 0x58, 0xad,
-  0x72, 0x2c, 0x44, 0x0e, 0x7b, 0x95, 0xc1, 0xa8, 0xbb, 0x44, 0x4a, 0x2b, 0x54, 0xb2, 0x1c, 0xb9,
-  0x4c, 0x96, 0x20, 0x26, 0x51, 0x45, 0x82, 0x6a, 0x57, 0x3d, 0xdf, 0xd9, 0x09, 0x73, 0x90, 0x15,
-  0xd2, 0x3a, 0x20, 0x8c, 0x1d, 0xae, 0x47, 0x97, 0xec, 0x3f, 0xa1, 0xb0, 0x80, 0x0a, 0x46, 0x99,
-  0x29, 0x8d, 0x65, 0xc1, 0x4b, 0xb0, 0xef, 0xa6, 0xdd, 0x8f, 0x4c, 0x51, 0x61, 0x09, 0xf3, 0xc1,
-  0xc3, 0xed, 0xcd, 0xc7, 0xe0, 0x56, 0xed, 0x21, 0x58, 0x58, 0xf0, 0xe9, 0xa5, 0x49, 0xaf, 0x49,
-  0x1d, 0x36, 0xf4, 0xb7, 0x32, 0x79, 0x73, 0xac, 0xa4, 0xdd, 0x28, 0x7d, 0x35, 0x6e, 0xd3, 0xa4,
-  0x97, 0xa6, 0x49, 0x5f, 0x9a, 0xd7, 0xce, 0xd3, 0x4c, 0xea, 0xbd, 0x74, 0xc1, 0x40, 0xe5, 0x82,
-  0xf9, 0x33, 0xa1, 0x27, 0xbd, 0x8c, 0x50, 0x32, 0xab, 0xb6, 0x38, 0x1f, 0xec, 0xa5, 0x0d, 0x32,
-  0x91, 0x9b, 0x6c, 0x57, 0x51, 0x22, 0xf1, 0x06, 0xf0, 0xa6, 0x04, 0x7f, 0xfc, 0xd0, 0x7c, 0xca,
-  0xc3, 0xde, 0x8d, 0x47, 0x25, 0xe4, 0x4e, 0x30, 0x16, 0x61, 0x61, 0x0d, 0x52, 0x16, 0xb9, 0x38,
-  0x9b, 0xcc, 0xd6, 0x3b, 0x9d, 0xa1, 0x32, 0x3a, 0xa0, 0x52, 0xaf, 0x3b, 0xd8, 0x90, 0x1f, 0xb3,
-  0xb8, 0xef, 0x5b, 0xfc, 0xd3, 0xe5, 0x45, 0xad, 0x74, 0x6e, 0xea, 0x58, 0x69, 0x0d, 0xf6, 0xa1,
-  0x6b, 0x60, 0x16, 0x17, 0xa0, 0x36, 0x05, 0x7e, 0xa3, 0xfe, 0xb5, 0x13, 0xb7, 0xaf, 0x90, 0x66,
-  0x5d, 0x66, 0x78, 0x10, 0x99, 0x4f, 0xea, 0xda, 0x37, 0xea, 0x80, 0x21, 0x9b, 0xe6, 0x8c, 0xcf,
-  0xd4, 0x3a, 0x24, 0x0d, 0x3f, 0x7a, 0x93, 0xda, 0xcd, 0xd0, 0x36, 0xc7, 0xda, 0x09, 0x34, 0xdb,
-  0xf8, 0x84, 0x59, 0xbb, 0x36, 0x93, 0x98, 0x15, 0x21, 0xf2, 0x63, 0x4b, 0xd6, 0xb5, 0x3b, 0x3f,
-  0xaf, 0x5d, 0x6c, 0xa9, 0x39, 0xcd, 0x1d, 0x4a, 0x04, 0x21, 0xc4, 0x03, 0xac, 0xee, 0x4c, 0xf6,
-  0x15, 0x30, 0xfe, 0xbc, 0xb8, 0xf9, 0x9d, 0x93, 0xda, 0x81, 0xa6, 0x92, 0x8f, 0x6f, 0xca, 0xfd,
-  0x9b, 0x2b, 0xb4, 0x3b, 0x68, 0x29, 0x14, 0x94, 0x0e, 0x8e, 0x25, 0x60, 0x80, 0xe2, 0x84, 0x5d,
-  0x1a, 0x82, 0xa6, 0xb2, 0x23, 0x10, 0x18, 0x6f, 0x25, 0x16, 0x7e, 0xae, 0x91, 0x15, 0x10, 0xbb,
-  0x92, 0xa8, 0x12, 0x4e, 0x22, 0x88, 0x09, 0xc8, 0x3d, 0x28, 0x2c, 0x42, 0x96, 0x30, 0xfe, 0xf3,
-  0x68, 0x72, 0xb5, 0x37, 0x2a, 0x0f, 0xc6, 0x3c, 0x76, 0xdb, 0x52, 0x61, 0x27, 0x8d, 0x34, 0xb9,
-  0x1b, 0xab, 0x68, 0x80, 0x94, 0xd7, 0xb6, 0x94, 0xe4, 0xca, 0x0a, 0xc4, 0x2d, 0x8b, 0x58, 0xed,
-  0x28, 0xb2, 0x8d, 0x4b, 0xd0, 0x1b, 0x2c, 0xe6, 0x93, 0xf3, 0xf3, 0x50, 0x0f, 0x05, 0x39, 0x0d,
-  0xed, 0xe3, 0x78, 0xc9, 0x23, 0x2a, 0x47, 0x68, 0xa8, 0x83, 0x97, 0x0a, 0x48, 0xcd, 0x12, 0xef,
-  0xc4, 0x63, 0xa3, 0xcd, 0x16, 0xb4, 0x08, 0xb9, 0x98, 0x1f, 0xff, 0xbf, 0xa4, 0xb6, 0x25, 0xf9,
-  0x4a, 0x69, 0x69, 0x9b, 0xfb, 0x66, 0x4b, 0x8c, 0x94, 0xd6, 0xca, 0x66, 0xb5, 0x5b, 0xaf, 0xc1,
-  0xb2, 0x88, 0x74, 0x32, 0xcf, 0x6f, 0xf6, 0xc4, 0x80, 0x5b, 0xe5, 0x88, 0x9c, 0x60, 0x43, 0x56,
-  0x81, 0x73, 0x72, 0x03, 0x34, 0x7f, 0x42, 0xf5, 0xdd, 0xa6, 0x96, 0xb2, 0x47, 0xb3, 0xfa, 0x0b,
-  0x32, 0x0c, 0x7e, 0xf1, 0xee, 0x1f, 0x3a, 0xf7, 0x25, 0xa3, 0xbe, 0xa2, 0xb9, 0x43, 0xab, 0xf4,
-  0x26, 0xa6, 0xa5, 0x28, 0x43, 0x8c, 0x73, 0x89, 0x92, 0xf3, 0x53, 0x0f, 0x7d, 0xda, 0x7f, 0x28,
-  0x8d, 0x97, 0x9d, 0x57, 0x08, 0x3e, 0x4e, 0x6f, 0xe1, 0x87, 0xfa, 0xe3, 0x0f, 0x67, 0x02, 0xa9,
-  0xc4, 0xa7, 0xa7, 0xa9, 0x3f, 0x4c, 0xe8, 0x70, 0xe6, 0x07, 0x6d, 0x01, 0x77, 0x56, 0xcf, 0x3c,
-  0x84, 0x25, 0xf9, 0x74, 0xe9, 0x9b, 0xf7, 0xf8, 0x76, 0x19, 0x49, 0xf1, 0x1b, 0x0d, 0x20, 0xa6,
-  0x3d, 0x0c, 0x4f, 0xc4, 0x4b, 0xec, 0x0b, 0xc9, 0x12, 0xcd, 0x23, 0xd5, 0x1b, 0xac, 0x4b, 0x63,
-  0x6c, 0xf8, 0x6c, 0x33, 0x92, 0x17, 0x96, 0x27, 0xd3, 0x9e, 0x62, 0x20, 0xde, 0xcd, 0xd6, 0xa4,
-  0x6c, 0x44, 0xfc, 0x7e, 0xd6, 0xa4, 0x7a, 0xd6, 0x0c, 0x87, 0xdc, 0x0b, 0x0e, 0x5e, 0x70, 0x48,
-  0xed, 0xec, 0x40, 0x02, 0xca, 0x22, 0x5e, 0xab, 0xb2, 0xbc, 0xf3, 0x6b, 0x26, 0xbe, 0xd8, 0xcd,
-  0x2a, 0xfc, 0xfe, 0x88, 0x8f, 0xb0, 0x6c, 0xa3, 0xee, 0x7f, 0x38, 0x79, 0x39, 0x4d, 0x97, 0x2d,
-  0xff, 0x12, 0x79, 0x87, 0x15, 0xd0, 0x70, 0x17, 0x14, 0x3f, 0xe4, 0xdd, 0x5d, 0xda, 0x2c, 0x3c,
-  0x5c, 0xc8, 0xa1, 0x8a, 0x9a, 0x0b, 0x19, 0xc5, 0xef, 0xe8, 0x33, 0x8e, 0xa6, 0x17, 0x5d, 0x86,
-  0x8b, 0x4f, 0xbd, 0x8d, 0x0f, 0x42, 0xe6, 0x30, 0x14, 0x6f, 0xdb, 0x7f, 0x39, 0x4c, 0xef, 0x84,
-  0x33, 0x25, 0xf1, 0xca, 0x5a, 0xca, 0x8c, 0x2d, 0x00, 0xbe, 0x06, 0x0f, 0x77, 0x41, 0x77, 0xbd,
-  0xa2, 0xb1, 0xd0, 0x50, 0x79, 0x7b, 0xe2, 0xe7, 0xb7, 0xe3, 0xb3, 0xe0, 0xd4, 0xdf, 0xcf, 0xd3,
-  0x7b, 0xde, 0xe0, 0xa7, 0xa7, 0xf0, 0xd5, 0xb6, 0xbd, 0xde, 0xec, 0x71, 0x44, 0x8a, 0x7b, 0x55,
-  0x81, 0xd9, 0x61, 0xd8, 0x11, 0xe9, 0xf5, 0xda, 0xb7, 0xd1, 0xf4, 0xfd, 0x98, 0xf3, 0x96, 0x0f,
-  0xe8, 0xd1, 0xe9, 0x1f, 0x91, 0x34, 0xe9, 0xdf, 0x9b, 0xa4, 0x7b, 0x5d, 0xff, 0x01, 0x47, 0xe8,
-  0xd7, 0x03, 0x73, 0x05, 0x00, 0x00
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x56, 0x6b, 0x73, 0xeb, 0xb6,
+  0x11, 0xfd, 0xce, 0x5f, 0xb1, 0x66, 0x3a, 0x16, 0x69, 0xd1, 0xa4, 0x1e, 0xf7, 0xe1, 0x58, 0xa2,
+  0x33, 0x37, 0xf7, 0xba, 0xe3, 0xcc, 0xb8, 0xb1, 0x27, 0xbe, 0x1d, 0xb5, 0xa3, 0x51, 0x27, 0x10,
+  0xb8, 0x92, 0x50, 0x81, 0x80, 0x0a, 0x80, 0x7a, 0xd4, 0xd1, 0x7f, 0xef, 0x2c, 0x48, 0xca, 0xf6,
+  0x4d, 0x52, 0x7d, 0xb0, 0x09, 0x60, 0xf7, 0xec, 0x03, 0xbb, 0x67, 0x31, 0x3e, 0xfb, 0xf2, 0xf0,
+  0xf9, 0xeb, 0x3f, 0x1f, 0x6f, 0x61, 0xe5, 0x4a, 0x79, 0x13, 0x8c, 0xdb, 0x7f, 0xc8, 0x8a, 0x9b,
+  0x60, 0x5c, 0xa2, 0x63, 0xa0, 0x58, 0x89, 0x79, 0xb8, 0x15, 0xb8, 0xdb, 0x68, 0xe3, 0x42, 0xe0,
+  0x5a, 0x39, 0x54, 0x2e, 0x0f, 0x77, 0xa2, 0x70, 0xab, 0xbc, 0xc0, 0xad, 0xe0, 0x78, 0xe9, 0x17,
+  0x09, 0x08, 0x25, 0x9c, 0x60, 0xf2, 0xd2, 0x72, 0x26, 0x31, 0xef, 0x27, 0x50, 0x0a, 0x25, 0xca,
+  0xaa, 0x6c, 0x37, 0xc2, 0x16, 0x95, 0xaf, 0x98, 0xb1, 0xe8, 0xf2, 0xb0, 0x72, 0x8b, 0xcb, 0xab,
+  0xf0, 0xad, 0x31, 0xb7, 0xc2, 0x12, 0x2f, 0xb9, 0x96, 0xda, 0xbc, 0xb2, 0xf7, 0xdd, 0xc0, 0xff,
+  0x48, 0xd6, 0x09, 0x27, 0xf1, 0x66, 0x72, 0x7f, 0xfb, 0x05, 0xee, 0xc5, 0x16, 0xe1, 0xd1, 0x20,
+  0x39, 0x38, 0xce, 0xea, 0x83, 0x60, 0x6c, 0xdd, 0x81, 0xfe, 0xcf, 0x75, 0x71, 0x80, 0xe7, 0xa0,
+  0x64, 0x66, 0x29, 0xd4, 0x35, 0xf4, 0x46, 0xc1, 0x31, 0x18, 0x67, 0xcd, 0xe1, 0x38, 0x6b, 0xc2,
+  0x24, 0xa9, 0x9b, 0x60, 0xcc, 0x99, 0xda, 0x32, 0x0b, 0xa2, 0xc8, 0x43, 0xfa, 0x0c, 0x6f, 0xc6,
+  0x59, 0xbd, 0x45, 0x78, 0xdc, 0x88, 0x8d, 0xbb, 0x09, 0xb6, 0xcc, 0x00, 0x87, 0x1c, 0x0a, 0xcd,
+  0xab, 0x12, 0x95, 0x4b, 0x97, 0xe8, 0x6e, 0x25, 0xd2, 0xe7, 0x8f, 0x87, 0x9f, 0x8a, 0xa8, 0x43,
+  0x1a, 0x9d, 0x78, 0xe4, 0x05, 0x25, 0x16, 0x16, 0x72, 0x08, 0xc3, 0x7a, 0xe9, 0x56, 0x46, 0x3b,
+  0x27, 0xb1, 0x80, 0x1c, 0x16, 0x4c, 0x5a, 0x1c, 0x05, 0x8b, 0x4a, 0x71, 0x27, 0xb4, 0x02, 0x8b,
+  0xee, 0xb3, 0xb7, 0x15, 0xc5, 0xf0, 0x1c, 0xf0, 0xd4, 0xa7, 0x13, 0x20, 0x87, 0x9d, 0x50, 0x85,
+  0xde, 0xa5, 0x42, 0x29, 0x34, 0x13, 0xbf, 0x79, 0x01, 0xbd, 0xf4, 0xfb, 0xab, 0x11, 0x64, 0x99,
+  0xc1, 0x52, 0x6f, 0x11, 0x2c, 0x37, 0x5a, 0x4a, 0x98, 0x33, 0x63, 0x03, 0x9e, 0xae, 0x50, 0x2c,
+  0x57, 0xee, 0x1b, 0xcd, 0xbb, 0x7a, 0xf3, 0xff, 0xaa, 0x1e, 0x83, 0x57, 0x4e, 0x8c, 0x82, 0x2c,
+  0x83, 0xcf, 0x2b, 0xe4, 0x6b, 0x58, 0x68, 0x03, 0x4d, 0x6a, 0x6c, 0xb5, 0xa1, 0x1a, 0xa8, 0xb3,
+  0xe0, 0xf6, 0x90, 0x03, 0xa7, 0x04, 0x7c, 0xa6, 0x1b, 0xda, 0xbb, 0xa8, 0x33, 0x28, 0x28, 0x74,
+  0xb1, 0x80, 0x88, 0xbb, 0x7d, 0x0c, 0xcf, 0x90, 0x65, 0xf0, 0x89, 0x73, 0xb4, 0x16, 0xdc, 0x0a,
+  0xc1, 0xa0, 0x2a, 0xd0, 0x08, 0xb5, 0xac, 0xef, 0x74, 0xef, 0xc8, 0x48, 0x65, 0x11, 0x36, 0xcc,
+  0xa0, 0x72, 0x30, 0x79, 0x02, 0x6d, 0x40, 0x6f, 0x50, 0x81, 0xc2, 0x9d, 0xb7, 0xb2, 0xb3, 0xa3,
+  0xc0, 0x19, 0xba, 0xc3, 0x1d, 0xa5, 0xd2, 0xe9, 0x4d, 0xda, 0xc4, 0x45, 0x27, 0x47, 0xe0, 0xcc,
+  0xf1, 0x15, 0x44, 0x18, 0xc3, 0xf3, 0xd1, 0x1b, 0xde, 0x59, 0x38, 0x3f, 0x87, 0x9d, 0x4d, 0x0d,
+  0xb2, 0xe2, 0xf0, 0xe4, 0x98, 0x43, 0xc8, 0xf3, 0x1c, 0x26, 0x38, 0x7f, 0xd2, 0x7c, 0x8d, 0x2e,
+  0x7d, 0x78, 0xbc, 0xfd, 0x39, 0xf6, 0x80, 0xa9, 0x45, 0x55, 0x44, 0x9d, 0xe7, 0x50, 0x6e, 0xc3,
+  0xeb, 0xe1, 0x91, 0x7c, 0x3f, 0x02, 0x4a, 0x8b, 0xf0, 0x1c, 0x48, 0x74, 0x20, 0x5f, 0xb2, 0x28,
+  0x35, 0x67, 0x74, 0x51, 0x23, 0x7f, 0xb0, 0x61, 0x6e, 0xa5, 0x20, 0x07, 0x99, 0xfa, 0x2f, 0x56,
+  0xe2, 0xcb, 0x3e, 0xb9, 0xe9, 0x77, 0x53, 0x2b, 0x05, 0xc7, 0xa8, 0x9f, 0xd4, 0x2b, 0x54, 0x85,
+  0x9d, 0x08, 0xb7, 0x8a, 0x3a, 0x59, 0x27, 0xfe, 0xe1, 0xb2, 0x7f, 0x5d, 0xa9, 0x02, 0x17, 0x42,
+  0x61, 0x11, 0xa7, 0x76, 0x23, 0x85, 0x8b, 0xc2, 0x2c, 0x8c, 0x6b, 0x9c, 0xca, 0x48, 0x8f, 0xae,
+  0x8d, 0x58, 0x0a, 0x95, 0x1a, 0xdc, 0x48, 0xc6, 0x31, 0x0a, 0x57, 0xce, 0x6d, 0xc2, 0x24, 0xdc,
+  0xd9, 0xb0, 0x49, 0xb3, 0x37, 0x98, 0x4a, 0x54, 0x4b, 0xb7, 0x82, 0x1b, 0xe8, 0x53, 0x5c, 0xa4,
+  0xdc, 0xcd, 0x01, 0xc2, 0x2c, 0x84, 0x6e, 0xed, 0xd2, 0xb4, 0x37, 0xa3, 0xca, 0xf7, 0x29, 0x54,
+  0xb8, 0x7b, 0x49, 0x46, 0x54, 0x19, 0xd9, 0x0d, 0xb3, 0x1a, 0x70, 0x67, 0x53, 0xad, 0x7c, 0xf6,
+  0x73, 0x88, 0xe2, 0xfc, 0xe6, 0xcf, 0x52, 0xe4, 0x91, 0xd2, 0xb9, 0x50, 0xcc, 0x1c, 0xbe, 0x1e,
+  0x36, 0x48, 0x25, 0xce, 0x8c, 0x61, 0x87, 0x79, 0xb5, 0x58, 0xa0, 0x09, 0x3d, 0x12, 0x2b, 0x8a,
+  0xdb, 0x2d, 0x2a, 0x77, 0x2f, 0xac, 0x43, 0x85, 0x26, 0xea, 0x94, 0x68, 0x2d, 0x5b, 0x62, 0x27,
+  0x89, 0xd0, 0x83, 0xd7, 0xd7, 0x4a, 0x51, 0x38, 0xfd, 0xe4, 0xa8, 0x2c, 0x52, 0xce, 0xa4, 0x8c,
+  0x30, 0x2d, 0x98, 0x63, 0xb1, 0xbf, 0xb5, 0xce, 0x54, 0xcf, 0xff, 0x8d, 0xdc, 0xc1, 0x27, 0xc2,
+  0xff, 0xd1, 0xe3, 0xcf, 0x3a, 0x71, 0x7b, 0x3f, 0x75, 0x7f, 0x51, 0x44, 0x7f, 0x17, 0xca, 0x5d,
+  0x79, 0xa1, 0x56, 0xbf, 0x4e, 0x10, 0x89, 0x4c, 0x7b, 0x33, 0x38, 0xcb, 0xe1, 0xe3, 0x07, 0xf8,
+  0xed, 0x37, 0x38, 0xf3, 0x95, 0x69, 0xd0, 0x55, 0x46, 0x51, 0x23, 0x74, 0xee, 0x3b, 0x09, 0x75,
+  0x1f, 0x08, 0x45, 0x55, 0xc3, 0x37, 0x1b, 0x0f, 0x5d, 0x4e, 0x12, 0x28, 0xef, 0x12, 0x10, 0x90,
+  0x13, 0x6b, 0x9c, 0xa0, 0xfa, 0x33, 0xc8, 0x73, 0x18, 0xc6, 0x8d, 0xe7, 0x67, 0x05, 0x72, 0x5d,
+  0xa0, 0x3f, 0x8b, 0x4f, 0xb0, 0x41, 0x39, 0xa1, 0x14, 0x7a, 0x85, 0x8f, 0xb3, 0xf1, 0xf8, 0x2a,
+  0x86, 0xae, 0x77, 0x76, 0x7a, 0x35, 0x23, 0x9b, 0x50, 0x32, 0x67, 0xc4, 0x1e, 0x7c, 0x93, 0x07,
+  0xe5, 0xdd, 0x49, 0xf8, 0xfb, 0x37, 0xc2, 0xfd, 0xde, 0x1b, 0xe9, 0xba, 0xb1, 0x6b, 0xb3, 0xe5,
+  0xc4, 0xc7, 0x52, 0xde, 0x51, 0x93, 0x79, 0x6b, 0x72, 0xdb, 0x94, 0x41, 0x36, 0x1c, 0x81, 0x87,
+  0xec, 0x8f, 0xe0, 0x48, 0xea, 0xfd, 0x2f, 0x60, 0x9d, 0x11, 0x14, 0x97, 0x4f, 0x97, 0xdc, 0x9e,
+  0xca, 0xfc, 0x9b, 0xb0, 0x06, 0x14, 0x56, 0x8d, 0x46, 0x9b, 0x83, 0x3f, 0x73, 0xd6, 0x9f, 0x0e,
+  0xff, 0xd0, 0x39, 0xc8, 0xe1, 0xdd, 0x09, 0xbe, 0x4d, 0x87, 0x6f, 0x8d, 0xc7, 0x7b, 0xc8, 0xe1,
+  0x6f, 0xcc, 0xad, 0xd2, 0x52, 0xa8, 0xa8, 0x65, 0xb8, 0xcc, 0x67, 0xfa, 0xc4, 0x5a, 0x19, 0x94,
+  0x77, 0xb1, 0xc7, 0xdd, 0x88, 0x3d, 0x4a, 0x0b, 0x1b, 0x34, 0x40, 0x2c, 0x1f, 0xd5, 0xe2, 0x7a,
+  0x01, 0x5c, 0x18, 0x2e, 0x31, 0xae, 0x0b, 0xe0, 0x61, 0xd1, 0x82, 0x2e, 0xa4, 0xd6, 0x26, 0x3a,
+  0xe1, 0x5e, 0x92, 0xc1, 0x8b, 0x72, 0x12, 0x67, 0x03, 0x8f, 0x27, 0x71, 0xe1, 0x40, 0x2f, 0x16,
+  0x48, 0x57, 0x1d, 0x39, 0x0d, 0x1c, 0x95, 0x43, 0xd3, 0xb8, 0x1f, 0x07, 0x44, 0x72, 0xd1, 0x21,
+  0xef, 0xa5, 0xef, 0x47, 0x87, 0x71, 0x79, 0x37, 0x3a, 0x74, 0xbb, 0xb1, 0x67, 0xbe, 0x68, 0xef,
+  0x37, 0x61, 0x3f, 0x2e, 0x27, 0x23, 0xd8, 0xd3, 0xf6, 0x73, 0xc0, 0xdd, 0x3e, 0x5d, 0x08, 0x29,
+  0x9f, 0x68, 0x90, 0x40, 0x0e, 0xbf, 0x9a, 0xe5, 0x3c, 0xfa, 0xcb, 0xb3, 0xcf, 0x8b, 0x98, 0x1d,
+  0x93, 0xf6, 0xb3, 0xdb, 0x7f, 0xbd, 0x18, 0xcc, 0x8e, 0xf1, 0xaf, 0x23, 0xaf, 0x3c, 0xc7, 0xa5,
+  0x50, 0x8f, 0xcc, 0xad, 0x88, 0x69, 0x69, 0x83, 0x19, 0x1e, 0xed, 0x2f, 0x36, 0x8f, 0xf7, 0x5d,
+  0xf9, 0xb0, 0x48, 0xe0, 0x40, 0x9f, 0x89, 0x8f, 0xa1, 0x97, 0xbe, 0x4b, 0xa0, 0x97, 0xc0, 0x00,
+  0x2e, 0xea, 0x48, 0x1f, 0x7f, 0x6a, 0x74, 0xc8, 0x03, 0xd2, 0x17, 0xdd, 0x7c, 0x58, 0xb7, 0xe5,
+  0x0b, 0x1f, 0x1a, 0xe3, 0xfd, 0xd4, 0xca, 0x6a, 0x89, 0x29, 0x1a, 0xa3, 0x4d, 0x14, 0x3e, 0x22,
+  0xae, 0x89, 0x64, 0xfd, 0xf2, 0x3a, 0x4c, 0x48, 0xca, 0x2b, 0xfa, 0xbf, 0x59, 0x06, 0x05, 0x4a,
+  0xc7, 0x40, 0xd2, 0x44, 0xa5, 0x71, 0x0a, 0xd1, 0x16, 0x8d, 0xa5, 0xf1, 0x34, 0x8c, 0xaf, 0x61,
+  0x8d, 0x87, 0x85, 0x61, 0x25, 0x12, 0x47, 0xff, 0xe3, 0xe1, 0x17, 0x30, 0x95, 0xb2, 0xc0, 0x96,
+  0x4c, 0x28, 0xeb, 0x3c, 0xbd, 0x4b, 0x66, 0x1d, 0x30, 0xbe, 0x56, 0x7a, 0x27, 0xb1, 0x58, 0x62,
+  0x01, 0x5e, 0x9e, 0xda, 0x0b, 0xdb, 0xde, 0xca, 0x32, 0xc0, 0x2d, 0x9a, 0x03, 0xd4, 0x8d, 0xd3,
+  0x88, 0x80, 0xb0, 0x6f, 0x14, 0x13, 0x20, 0x72, 0xe4, 0xba, 0x60, 0x73, 0x89, 0xb5, 0x57, 0x16,
+  0x98, 0x41, 0x50, 0xda, 0x25, 0x60, 0x35, 0xb0, 0x17, 0x6f, 0x16, 0x5a, 0x4a, 0xbd, 0xb3, 0xf5,
+  0xc0, 0xdd, 0x12, 0x1d, 0x54, 0x52, 0x26, 0x20, 0xb7, 0x4f, 0xf8, 0x9f, 0xba, 0x79, 0x4f, 0x43,
+  0xb6, 0x69, 0xd6, 0xa2, 0xe5, 0x0f, 0x4f, 0x74, 0xc5, 0xf4, 0x7d, 0xdb, 0x75, 0xc5, 0xf4, 0xc3,
+  0xac, 0xee, 0xf5, 0x62, 0x3a, 0xf0, 0x1d, 0xd1, 0x8b, 0x6b, 0xcc, 0xa2, 0x25, 0xf3, 0x7e, 0x02,
+  0xfd, 0x3e, 0x74, 0x41, 0x5d, 0x0c, 0xe3, 0x51, 0xd0, 0xcc, 0x0a, 0xdf, 0x92, 0x72, 0x4b, 0x2d,
+  0x79, 0x6a, 0x43, 0x62, 0x1c, 0x75, 0x31, 0xa4, 0xbd, 0x62, 0xfa, 0xce, 0x13, 0x90, 0x77, 0xa9,
+  0x25, 0x89, 0xd3, 0x0b, 0x80, 0x6a, 0xcc, 0x37, 0x08, 0xb5, 0x6c, 0xbf, 0x65, 0x1c, 0xd8, 0xc0,
+  0x18, 0x8a, 0x16, 0xeb, 0xfc, 0x1c, 0x04, 0x8c, 0x41, 0x8d, 0x5a, 0xcf, 0x0d, 0xf9, 0x34, 0xdd,
+  0x74, 0xbb, 0x8d, 0xbf, 0x06, 0xce, 0xa1, 0xb7, 0xbf, 0xea, 0x11, 0x1d, 0x08, 0x62, 0xff, 0x66,
+  0xe7, 0xe3, 0x5f, 0x29, 0xae, 0xfe, 0xc8, 0x0f, 0x5c, 0xa1, 0x2a, 0x6c, 0x38, 0xa1, 0x52, 0x7c,
+  0xc5, 0x14, 0x5d, 0xd1, 0xfd, 0xed, 0x17, 0xfb, 0xe2, 0xc4, 0xba, 0x36, 0xbe, 0x86, 0x31, 0x44,
+  0xa6, 0xdb, 0x8f, 0x2f, 0x86, 0x23, 0x58, 0x53, 0xcd, 0xcb, 0xed, 0x54, 0x5c, 0x0c, 0xbb, 0xeb,
+  0x19, 0xfc, 0xeb, 0x95, 0x65, 0xb2, 0x64, 0xbc, 0x01, 0x5f, 0x7e, 0x6d, 0xce, 0x0b, 0x22, 0x87,
+  0xd3, 0xf0, 0xf8, 0x86, 0x9e, 0xa7, 0x1f, 0xde, 0x37, 0xb7, 0x33, 0x8b, 0x7d, 0x6b, 0x76, 0x3e,
+  0x75, 0x82, 0x26, 0x27, 0xce, 0x54, 0xd8, 0x94, 0x62, 0x33, 0x77, 0x0d, 0x5a, 0xf1, 0x5f, 0xa4,
+  0x9a, 0x51, 0x0e, 0x64, 0x33, 0x4b, 0x82, 0xe6, 0xf0, 0xf7, 0x33, 0xa6, 0x16, 0xef, 0x24, 0xd0,
+  0xcc, 0x18, 0x7f, 0x33, 0xa7, 0x77, 0x17, 0x65, 0x87, 0x7e, 0x59, 0x06, 0x5a, 0xc9, 0x03, 0x55,
+  0x30, 0x51, 0xe0, 0x0e, 0x3b, 0x75, 0x69, 0xbd, 0xbc, 0xd0, 0xde, 0x3c, 0x85, 0xa0, 0x55, 0x62,
+  0xdc, 0x55, 0x4c, 0x02, 0x4d, 0xa9, 0x39, 0xe3, 0x6b, 0x5a, 0x0b, 0xad, 0x82, 0xd7, 0xef, 0x3a,
+  0x1f, 0x01, 0xc9, 0xd6, 0xa0, 0xa7, 0xa3, 0x33, 0x42, 0xfc, 0x2a, 0x4a, 0xd4, 0x95, 0x8b, 0xfc,
+  0x70, 0xf5, 0x88, 0xc4, 0x46, 0x0c, 0x5c, 0xbd, 0x0f, 0x4e, 0x43, 0xa5, 0x2e, 0x5b, 0x9d, 0xe0,
+  0x0f, 0xde, 0x8b, 0xc7, 0x04, 0x06, 0xef, 0x7b, 0xa7, 0xa6, 0x1d, 0x67, 0xed, 0xbb, 0x74, 0x9c,
+  0x35, 0x8f, 0xd8, 0xcc, 0xbf, 0xe0, 0xff, 0x07, 0xaa, 0x92, 0xf7, 0x1d, 0xd8, 0x0b, 0x00, 0x00
 };
 
 
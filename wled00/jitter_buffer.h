@@ -0,0 +1,143 @@
+#ifndef WLED_JITTER_BUFFER_H
+#define WLED_JITTER_BUFFER_H
+
+/*
+ * Realtime frame jitter buffer (playout timing only, frame data is stored by the caller)
+ *
+ * Frames are keyed by source time in ms: the DDP timecode if the sender supplies one,
+ * otherwise the arrival time smoothed to the average frame interval.
+ * A frame is due at source time + offset, where offset is anchored so that
+ * about "depth" frames are buffered.
+ */
+
+#include <stdint.h>
+
+#ifndef WLED_MAX_JITTER_FRAMES
+  #ifdef ESP8266
+    #define WLED_MAX_JITTER_FRAMES 2
+  #else
+    #define WLED_MAX_JITTER_FRAMES 4
+  #endif
+#endif
+
+class JitterBuffer {
+  public:
+    JitterBuffer() { reset(0); }
+
+    void reset(uint8_t depth) {
+      _depth = depth > WLED_MAX_JITTER_FRAMES ? WLED_MAX_JITTER_FRAMES : depth;
+      _head = _count = 0;
+      _anchored = _starved = _running = false;
+      _interval = 0;
+      _lastTs = _lastArrival = 0;
+      _underruns = _overruns = 0;
+    }
+
+    // DDP timecode (16.16 seconds) to ms
+    static uint32_t timecodeToMs(uint32_t tc) {
+      return (tc >> 16) * 1000UL + (((tc & 0xFFFF) * 1000UL) >> 16);
+    }
+
+    // reserve slot for a new frame, returns slot index (0 .. depth-1) or -1 if disabled
+    // on overrun the oldest frame is dropped
+    int8_t push(uint32_t ts, bool hasTimecode, uint32_t now) {
+      if (!_depth) return -1;
+      if (_starved) _anchored = false; // buffer ran dry, re-buffer
+      if (!hasTimecode) {
+        ts = now;
+        int32_t gap = (int32_t)(now - _lastArrival);
+        if (_running && gap <= 1000) {
+          if (!_starved) updateInterval(gap); // also across re-anchoring, late frames must count (a pause is not a frame)
+          if (_anchored) {
+            // smooth arrival time: follow predicted cadence, track least delayed arrivals
+            // (packets can only be late, an early one means the timeline is behind)
+            uint32_t predicted = _lastTs + getInterval();
+            int32_t  error = (int32_t)(now - predicted);
+            ts = predicted + (error < 0 ? error / 2 : error >> 5);
+          }
+        } else {
+          _anchored = false; // stream stalled, start over
+        }
+      } else if (_anchored) {
+        int32_t diff = (int32_t)(ts - _lastTs);
+        if (diff <= 0 || diff > 1000) _anchored = false; // source restarted or stalled, start over
+        else updateInterval(diff);
+      }
+      _lastArrival = now;
+      _running = true;
+      if (!_anchored) {
+        _offset = now - ts + delay();
+        _anchored = true;
+        _starved = false;
+        _count = 0;
+      } else if ((int32_t)(ts + _offset - now) > (int32_t)(2 * delay() + 1000)) {
+        _offset = now - ts + delay(); // due time too far ahead, timecode jumped
+      }
+      _lastTs = ts;
+
+      if (_count >= _depth) {
+        // oldest frame was not presented in time: drop it and play out slightly earlier
+        _head = (_head + 1) % _depth;
+        _count--;
+        _overruns++;
+        _offset -= getInterval() >> 2;
+      }
+      uint8_t slot = (_head + _count) % _depth;
+      _due[slot] = ts + _offset;
+      _count++;
+      return slot;
+    }
+
+    // returns slot index of frame that should be presented now or -1
+    int8_t pop(uint32_t now) {
+      if (!_depth || !_anchored) return -1;
+      if (!_count) {
+        // nothing buffered although next frame is overdue
+        uint32_t interval = getInterval();
+        if (!_starved && interval && (int32_t)(now - (_lastTs + _offset)) > (int32_t)(interval + (interval >> 1))) {
+          _underruns++;
+          _starved = true;
+        }
+        return -1;
+      }
+      if ((int32_t)(now - _due[_head]) < 0) return -1;
+      uint8_t slot = _head;
+      _head = (_head + 1) % _depth;
+      _count--;
+      return slot;
+    }
+
+    uint8_t  getDepth()     const { return _depth; }
+    uint8_t  getCount()     const { return _count; }
+    uint16_t getInterval()  const { return (_interval + 128) >> 8; }
+    uint32_t getUnderruns() const { return _underruns; }
+    uint32_t getOverruns()  const { return _overruns; }
+
+  private:
+    // playout delay: depth frames less half a frame, so a full buffer is due before the next frame arrives
+    uint32_t delay() const {
+      uint32_t interval = _interval ? getInterval() : 25U; // assume 40 FPS until measured
+      return _depth * interval - interval / 2;
+    }
+
+    void updateInterval(int32_t diff) {
+      if (diff < 0) return;
+      _interval = _interval ? (_interval * 15 + (diff << 8) + 8) >> 4 : diff << 8; // running average in 1/256 ms
+    }
+
+    uint32_t _due[WLED_MAX_JITTER_FRAMES]; // ms (local clock) each buffered frame is due
+    uint32_t _offset;                      // source time to local clock
+    uint32_t _lastTs;                      // source time of last frame
+    uint32_t _lastArrival;                 // local time last frame arrived
+    uint32_t _underruns;
+    uint32_t _overruns;
+    uint32_t _interval;                    // average frame interval in 1/256 ms
+    uint8_t  _depth;
+    uint8_t  _head;
+    uint8_t  _count;
+    bool     _anchored;
+    bool     _starved;
+    bool     _running;                     // _lastArrival is valid
+};
+
+#endif
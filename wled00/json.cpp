@@ -1,4 +1,5 @@
 #include "wled.h"
+#include <memory>
 
 #include "palettes.h"
 
@@ -100,6 +101,14 @@ bool deserializeSegment(JsonObject elem, byte it, byte presetId)
   uint8_t set = elem[F("set")] | seg.set;
   seg.set = constrain(set, 0, 3);
 
+  #ifndef WLED_DISABLE_2D
+  uint8_t renderScale = constrain(elem["rs"] | seg.renderScale, 0, 2);
+  if (renderScale != seg.renderScale) {
+    seg.renderScale = renderScale;
+    seg.markForReset(); // effect data may depend on virtual dimensions
+  }
+  #endif
+
   uint16_t len = 1;
   if (stop > start) len = stop - start;
   int offset = elem[F("of")] | INT32_MAX;
@@ -411,6 +420,9 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
 
   usermods.readFromJsonState(root);
 
+  const char *frame = root[F("frame")]; // stored binary pixel frame (after segments, may freeze them)
+  if (frame) applyPixelFrame(frame);
+
   loadLedmap = root[F("ledmap")] | loadLedmap;
 
   byte ps = root[F("psave")];
@@ -534,6 +546,9 @@ void serializeSegment(JsonObject& root, Segment& seg, byte id, bool forPreset, b
   root["o3"]  = seg.check3;
   root["si"]  = seg.soundSim;
   root["m12"] = seg.map1D2D;
+  #ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) root["rs"] = seg.renderScale;
+  #endif
 }
 
 void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
@@ -619,6 +634,13 @@ void serializeInfo(JsonObject root)
   }
   #endif
 
+  // frame budget governor
+  JsonObject gov = leds.createNestedObject(F("gov"));
+  gov[F("rt")] = strip.getRenderTime();    // us all effects took in last frame
+  gov[F("dn")] = strip.getQualityDrops();  // number of quality reductions
+  gov[F("up")] = strip.getQualityRaises(); // number of quality restorations
+  JsonArray qarr = gov.createNestedArray(F("q"));
+
   uint8_t totalLC = 0;
   JsonArray lcarr = leds.createNestedArray(F("seglc"));
   size_t nSegs = strip.getSegmentsNum();
@@ -627,6 +649,7 @@ void serializeInfo(JsonObject root)
     uint8_t lc = strip.getSegment(s).getLightCapabilities();
     totalLC |= lc;
     lcarr.add(lc);
+    qarr.add(strip.getSegment(s).getQuality());
   }
 
   leds["lc"] = totalLC;
@@ -635,6 +658,14 @@ void serializeInfo(JsonObject root)
   leds[F("wv")]   = totalLC & 0x02;     // deprecated, true if white slider should be displayed for any segment
   leds["cct"]     = totalLC & 0x04;     // deprecated, use info.leds.lc
 
+  // network bus output queue
+  JsonObject netout = leds.createNestedObject(F("netout"));
+  netout[F("q")]    = getNetworkOutputQueueDepth(); // packets waiting to be sent
+  netout[F("sent")] = (uint32_t)netOutSent;
+  netout[F("drop")] = (uint32_t)netOutDrops;
+  netout[F("lat")]  = (uint32_t)netOutLatency;              // average us from strip.show() to sent
+  netout[F("maxlat")] = (uint32_t)netOutMaxLatency;
+
   #ifdef WLED_DEBUG
   JsonArray i2c = root.createNestedArray(F("i2c"));
   i2c.add(i2c_sda);
@@ -671,6 +702,38 @@ void serializeInfo(JsonObject root)
     root[F("lip")] = realtimeIP.toString();
   }
 
+  JsonObject udpin = root.createNestedObject(F("udpin")); // realtime packet ingest
+  udpin["q"]       = getE131IngestDepth();
+  udpin[F("max")]  = (uint16_t)e131IngestPeak;
+  udpin[F("drop")] = (uint32_t)e131IngestDrops;
+  udpin[F("defer")] = udpIngestDeferred;
+
+  JsonObject jbuf = root.createNestedObject(F("jbuf")); // DDP jitter buffer
+  jbuf["d"]      = ddpJitter.getDepth();
+  jbuf["n"]      = ddpJitter.getCount();
+  jbuf[F("fi")]  = ddpJitter.getInterval();  // average frame interval (ms)
+  jbuf[F("un")]  = ddpJitter.getUnderruns();
+  jbuf[F("ov")]  = ddpJitter.getOverruns();
+
+  JsonObject jlock = root.createNestedObject(F("jlock")); // JSON buffer lock and API command queue
+  jlock[F("n")]    = jsonLockCount;
+  jlock[F("cont")] = jsonLockContended;
+  jlock[F("fail")] = jsonLockFailed;
+  jlock[F("wmax")] = jsonLockWaitMax;                                            // ms
+  jlock[F("wavg")] = jsonLockContended ? jsonLockWaitTotal / jsonLockContended : 0; // ms per contended request
+  jlock[F("q")]    = jsonCmdQueued;
+  jlock[F("dir")]  = jsonCmdDirect;
+  jlock[F("qmax")] = jsonCmdQueuePeak;
+
+  if (clockSyncMode != CLOCK_SYNC_OFF) {
+    JsonObject clk = root.createNestedObject(F("clock")); // effect clock sync
+    clk[F("role")] = clockSyncMode;
+    clk[F("lock")] = clockSync.isLocked();
+    clk[F("off")]  = clockSync.getOffset();  // us, filtered offset to master before correction
+    clk[F("jit")]  = clockSync.getJitter();  // us
+    clk[F("rtt")]  = clockSync.getDelay();   // us
+  }
+
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
   #else
@@ -824,19 +887,26 @@ void setPaletteColors(JsonArray json, byte* tcp)
     }
 }
 
+#ifdef ESP8266
+  #define PALETTES_PER_PAGE 5
+#else
+  #define PALETTES_PER_PAGE 8
+#endif
+
+static int getPaletteMaxPage()
+{
+  return (strip.getPaletteCount() + strip.customPalettes.size() - 1) / PALETTES_PER_PAGE;
+}
+
 void serializePalettes(JsonObject root, int page)
 {
   byte tcp[72];
-  #ifdef ESP8266
-  int itemPerPage = 5;
-  #else
-  int itemPerPage = 8;
-  #endif
+  int itemPerPage = PALETTES_PER_PAGE;
 
   int palettesCount = strip.getPaletteCount();
   int customPalettes = strip.customPalettes.size();
 
-  int maxPage = (palettesCount + customPalettes -1) / itemPerPage;
+  int maxPage = getPaletteMaxPage();
   if (page > maxPage) page = maxPage;
 
   int start = itemPerPage * page;
@@ -958,46 +1028,402 @@ void serializeNodes(JsonObject root)
 {
   JsonArray nodes = root.createNestedArray("nodes");
 
-  for (NodesMap::iterator it = Nodes.begin(); it != Nodes.end(); ++it)
+  for (size_t i = 0; i < Nodes.size(); i++)
   {
-    if (it->second.ip[0] != 0)
-    {
-      JsonObject node = nodes.createNestedObject();
-      node[F("name")] = it->second.nodeName;
-      node["type"]    = it->second.nodeType;
-      node["ip"]      = it->second.ip.toString();
-      node[F("age")]  = it->second.age;
-      node[F("vid")]  = it->second.build;
-    }
+    const NodeStruct &n = Nodes[i];
+    JsonObject node = nodes.createNestedObject();
+    node[F("name")] = n.nodeName;
+    node["type"]    = n.nodeType;
+    node["ip"]      = IPAddress(n.ip).toString();
+    node[F("age")]  = n.age;
+    node[F("vid")]  = n.build;
   }
 }
 
-// deserializes mode data string into JsonArray
-void serializeModeData(JsonArray fxdata)
+/*
+ * Compact binary node list for UIs polling large installations (no JSON buffer lock needed)
+ * Header: [0] version 1 [1] entry size [2-3] node count (LE)
+ * Entry:  [0-3] IP [4] type [5] age [6-9] build (LE) [10-41] name (zero padded)
+ */
+#define NODES_BIN_HEADER 4
+#define NODES_BIN_ENTRY (10 + NODE_NAME_LEN)
+
+void serveNodesBinary(AsyncWebServerRequest* request)
 {
-  char lineBuffer[128];
-  for (size_t i = 0; i < strip.getModeCount(); i++) {
-    strncpy_P(lineBuffer, strip.getModeData(i), 127);
-    if (lineBuffer[0] != 0) {
+  size_t count = nodeListEnabled ? Nodes.size() : 0;
+  AsyncResponseStream *response = request->beginResponseStream("application/octet-stream", NODES_BIN_HEADER + count * NODES_BIN_ENTRY);
+  uint8_t buf[NODES_BIN_ENTRY];
+  buf[0] = 1;
+  buf[1] = NODES_BIN_ENTRY;
+  buf[2] = count & 0xFF;
+  buf[3] = count >> 8;
+  response->write(buf, NODES_BIN_HEADER);
+  for (size_t i = 0; i < count; i++) {
+    const NodeStruct &n = Nodes[i];
+    IPAddress ip(n.ip);
+    for (size_t x = 0; x < 4; x++) buf[x] = ip[x];
+    buf[4] = n.nodeType;
+    buf[5] = n.age;
+    for (size_t x = 0; x < 4; x++) buf[6+x] = n.build >> (8*x);
+    strncpy((char*)buf + 10, n.nodeName, NODE_NAME_LEN); // pads with zeros
+    response->write(buf, NODES_BIN_ENTRY);
+  }
+  request->send(response);
+}
+
+/*
+ * JSON buffer serialized once into RAM (PSRAM if available) so the JSON buffer lock can be released before the
+ * response is sent, the responses sending it keep it alive.
+ */
+class JsonOutBuffer {
+  public:
+    ~JsonOutBuffer() { free(_data); }
+
+    size_t length() const { return _len; }
+
+    // JSON buffer lock must be held, without the last trim bytes of the document
+    bool serialize(size_t trim = 0) {
+      size_t size = measureJson(doc) + 1;
+      if (size > _size) { // grows only, reused while the size fits
+        free(_data);
+        _size = 0;
+        #if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM) && defined(WLED_USE_PSRAM)
+        if (psramFound())
+          _data = (char*) ps_malloc(size);
+        else
+        #endif
+          _data = (char*) malloc(size);
+        if (!_data) return false;
+        _size = size;
+      }
+      _len = serializeJson(doc, _data, _size) - trim;
+      return true;
+    }
+
+    size_t fill(uint8_t *buffer, size_t maxLen, size_t index) const {
+      if (index >= _len) return 0;
+      size_t n = std::min(maxLen, _len - index);
+      memcpy(buffer, _data + index, n);
+      return n;
+    }
+
+  private:
+    char  *_data = nullptr;
+    size_t _size = 0;
+    size_t _len = 0;
+};
+
+/*
+ * Effect names (/json/eff, /json) and effect data (/json/fxdata) are streamed from flash in the chunks of the
+ * response instead of being copied into the JSON buffer first. Only state and info of /json go through it.
+ */
+class ModeListStream {
+  public:
+    std::unique_ptr<JsonOutBuffer> stateInfo; // /json: sent first
+    String head;           // sent before the list
+    bool   data = false;   // effect data instead of names
+    bool   full = false;   // /json: palette names and closing brace follow
+
+    size_t fill(uint8_t *buffer, size_t maxLen) {
+      char item[2*128+4];  // worst case if every character is escaped
+      size_t n = 0;
+      while (n < maxLen) {
+        const char *src;
+        size_t len;
+        bool pgm = false;
+        switch (_phase) {
+          case 0:
+            if (stateInfo && _pos < stateInfo->length()) {
+              size_t count = stateInfo->fill(buffer + n, maxLen - n, _pos);
+              n += count;
+              _pos += count;
+              continue;
+            }
+            stateInfo.reset(); // no longer needed
+            _pos = 0;
+            _phase++;
+            continue;
+          case 1: src = head.c_str(); len = head.length(); break;
+          case 2:
+            if (_mode >= strip.getModeCount()) { _phase++; continue; }
+            len = getItem(item);
+            if (!len) { _mode++; continue; } // reserved mode slot
+            src = item;
+            break;
+          case 3: src = full ? "],\"palettes\":" : "]"; len = strlen(src); break;
+          case 4: if (!full) { _phase++; continue; } src = JSON_palette_names; len = strlen_P(src); pgm = true; break;
+          case 5: if (!full) { _phase++; continue; } src = "}"; len = 1; break;
+          default: return n;
+        }
+        size_t count = std::min(len - _pos, maxLen - n);
+        if (pgm) memcpy_P(buffer + n, src + _pos, count);
+        else     memcpy(buffer + n, src + _pos, count);
+        n += count;
+        _pos += count;
+        if (_pos < len) continue;
+        _pos = 0;
+        if (_phase == 2) { _mode++; _items++; }
+        else {
+          if (_phase == 1) head = String(); // no longer needed
+          _phase++;
+        }
+      }
+      return n;
+    }
+
+  private:
+    // quoted (and escaped) list item of current mode, empty if mode does not exist
+    size_t getItem(char *item) {
+      char lineBuffer[128];
+      strncpy_P(lineBuffer, strip.getModeData(_mode), 127);
+      lineBuffer[127] = 0;
+      if (lineBuffer[0] == 0) return 0;
       char* dataPtr = strchr(lineBuffer,'@');
-      if (dataPtr) fxdata.add(dataPtr+1);
-      else         fxdata.add("");
+      const char *src = lineBuffer;
+      if (data) src = dataPtr ? dataPtr+1 : "";
+      else if (dataPtr) *dataPtr = 0; // terminate mode data after name
+      size_t len = 0;
+      if (_items) item[len++] = ',';
+      item[len++] = '"';
+      for (; *src; src++) {
+        if (*src == '"' || *src == '\\') item[len++] = '\\';
+        item[len++] = *src;
+      }
+      item[len++] = '"';
+      return len;
     }
+
+    size_t   _pos = 0;   // position within current part
+    uint16_t _mode = 0;
+    uint16_t _items = 0; // items sent
+    uint8_t  _phase = 0; // state/info, head, list, list end, palette names, end
+};
+
+/*
+ * Cached /json/fxdata and /json/palx: built by the main loop some time after boot (palette pages again when custom
+ * palettes change) as gzip files and served directly, with the CRC of the content as strong ETag.
+ * Files left from a previous boot are kept if their gzip trailer (CRC and size) matches the current content.
+ * Until an item is built, or for clients not accepting gzip, responses are generated as before.
+ */
+#define JSON_CACHE_MAX_PAGES 20    // palette pages cached, more are generated on request
+#define JSON_CACHE_ITEMS (1 + JSON_CACHE_MAX_PAGES) // fxdata, then palette pages
+#define JSON_CACHE_DELAY 10000     // ms after boot
+#define JSON_CACHE_INTERVAL 200    // ms between items, spreads the work
+#define JSON_CACHE_DONE 255
+
+static uint32_t jsonCacheCrc[JSON_CACHE_ITEMS];   // of uncompressed content
+static bool     jsonCacheValid[JSON_CACHE_ITEMS];
+static uint8_t  jsonCacheNext = 0;                // next item to build
+static unsigned long jsonCacheLastBuild = 0;
+
+// file name without .gz (added by the web server when serving)
+static void getJsonCachePath(char *path, uint8_t item)
+{
+  if (item == 0) strcpy_P(path, PSTR("/cache/fxdata.json"));
+  else           sprintf_P(path, PSTR("/cache/palx%u.json"), item - 1);
+}
+
+void invalidateJsonCache()
+{
+  for (size_t i = 1; i < JSON_CACHE_ITEMS; i++) jsonCacheValid[i] = false;
+  if (jsonCacheNext > 1) jsonCacheNext = 1;
+}
+
+// passes bytes to a GzipWriter::Sink
+class SinkPrint : public Print {
+  public:
+    SinkPrint(GzipWriter::Sink sink, void *ctx) : _sink(sink), _ctx(ctx) {}
+    using Print::write;
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *data, size_t len) override { return _sink(data, len, _ctx) ? len : 0; }
+  private:
+    GzipWriter::Sink _sink;
+    void *_ctx;
+};
+
+// writes content of item (palette pages: in doc, JSON buffer locked by caller)
+static void writeJsonCacheItem(uint8_t item, GzipWriter::Sink sink, void *ctx)
+{
+  if (item == 0) {
+    ModeListStream fxdata;
+    fxdata.head = "[";
+    fxdata.data = true;
+    uint8_t buf[128];
+    size_t len;
+    while ((len = fxdata.fill(buf, sizeof(buf)))) sink(buf, len, ctx);
+  } else {
+    SinkPrint out(sink, ctx);
+    serializeJson(doc, out);
   }
 }
 
-// deserializes mode names string into JsonArray
-// also removes effect data extensions (@...) from deserialised names
-void serializeModeNames(JsonArray arr) {
-  char lineBuffer[128];
-  for (size_t i = 0; i < strip.getModeCount(); i++) {
-    strncpy_P(lineBuffer, strip.getModeData(i), 127);
-    if (lineBuffer[0] != 0) {
-      char* dataPtr = strchr(lineBuffer,'@');
-      if (dataPtr) *dataPtr = 0; // terminate mode data after name
-      arr.add(lineBuffer);
+struct JsonCacheCrc { uint32_t crc; uint32_t size; };
+
+static bool crcSink(const uint8_t *data, size_t len, void *ctx)
+{
+  JsonCacheCrc *c = (JsonCacheCrc*)ctx;
+  c->crc = GzipWriter::crc32(c->crc, data, len);
+  c->size += len;
+  return true;
+}
+
+static bool gzipSink(const uint8_t *data, size_t len, void *ctx)
+{
+  return ((GzipWriter*)ctx)->write(data, len);
+}
+
+static bool fileSink(const uint8_t *data, size_t len, void *ctx)
+{
+  return ((File*)ctx)->write(data, len) == len;
+}
+
+// builds one cache item per call
+void handleJsonCache()
+{
+  if (jsonCacheNext == JSON_CACHE_DONE || millis() < JSON_CACHE_DELAY || millis() - jsonCacheLastBuild < JSON_CACHE_INTERVAL) return;
+  uint8_t item = jsonCacheNext;
+  if (item > getPaletteMaxPage() + 1 || item >= JSON_CACHE_ITEMS) { jsonCacheNext = JSON_CACHE_DONE; return; }
+  if (item > 0) {
+    if (jsonBufferLock || !requestJSONBufferLock(23)) return; // try again next loop
+    serializePalettes(doc.to<JsonObject>(), item - 1);
+  }
+  jsonCacheLastBuild = millis();
+  jsonCacheNext++;
+
+  JsonCacheCrc content = {0, 0};
+  writeJsonCacheItem(item, crcSink, &content);
+
+  char path[32];
+  getJsonCachePath(path, item);
+  strcat_P(path, PSTR(".gz"));
+  bool valid = false;
+  File f = WLED_FS.open(path, "r");
+  if (f && f.size() >= 18 && f.seek(f.size() - 8)) { // reuse file if trailer matches
+    uint8_t trailer[8];
+    valid = f.read(trailer, 8) == 8
+         && content.crc  == (trailer[0] | trailer[1] << 8 | trailer[2] << 16 | (uint32_t)trailer[3] << 24)
+         && content.size == (trailer[4] | trailer[5] << 8 | trailer[6] << 16 | (uint32_t)trailer[7] << 24);
+  }
+  if (f) f.close();
+
+  if (!valid) {
+    DEBUG_PRINT(F("Writing JSON cache ")); DEBUG_PRINTLN(path);
+    WLED_FS.mkdir("/cache");
+    f = WLED_FS.open(path, "w");
+    if (f) {
+      GzipWriter gz(fileSink, &f);
+      writeJsonCacheItem(item, gzipSink, &gz);
+      valid = gz.finish() && gz.getCrc() == content.crc;
+      f.close();
+      if (!valid) WLED_FS.remove(path);
     }
   }
+  if (item > 0) releaseJSONBufferLock();
+  jsonCacheCrc[item] = content.crc;
+  jsonCacheValid[item] = valid;
+}
+
+// true if If-None-Match lists etag (as weak or strong tag) or is "*"
+static bool etagMatches(AsyncWebServerRequest* request, const char *etag)
+{
+  AsyncWebHeader* header = request->getHeader("If-None-Match");
+  if (!header) return false;
+  const char *list = header->value().c_str();
+  const size_t len = strlen(etag);
+  while (*list) {
+    while (*list == ' ' || *list == ',') list++;
+    if (*list == '*') return true;
+    if (!strncmp(list, "W/", 2)) list += 2;
+    if (!strncmp(list, etag, len) && (list[len] == 0 || list[len] == ',' || list[len] == ' ')) return true;
+    while (*list && *list != ',') list++;
+  }
+  return false;
+}
+
+static bool serveJsonCache(AsyncWebServerRequest* request, uint8_t item)
+{
+  if (item >= JSON_CACHE_ITEMS || !jsonCacheValid[item]) return false;
+  AsyncWebHeader* enc = request->getHeader("Accept-Encoding");
+  if (!enc || enc->value().indexOf("gzip") < 0) return false;
+
+  char etag[12];
+  sprintf_P(etag, PSTR("\"%08x\""), jsonCacheCrc[item]);
+  AsyncWebServerResponse *response;
+  if (etagMatches(request, etag)) {
+    response = request->beginResponse(304);
+  } else {
+    char path[32];
+    getJsonCachePath(path, item);
+    response = request->beginResponse(WLED_FS, path, "application/json"); // serves path.gz with Content-Encoding
+    if (!response || !response->_sourceValid()) {
+      delete response;
+      jsonCacheValid[item] = false; // file was removed
+      if (jsonCacheNext > item) jsonCacheNext = item;
+      return false;
+    }
+  }
+  response->addHeader(F("Cache-Control"), "no-cache");
+  response->addHeader(F("ETag"), etag);
+  request->send(response);
+  return true;
+}
+
+static void serveModeList(AsyncWebServerRequest* request, byte subJson)
+{
+  std::shared_ptr<ModeListStream> out = std::make_shared<ModeListStream>();
+  out->data = subJson == JSON_PATH_FXDATA;
+  out->full = subJson != JSON_PATH_FXDATA && subJson != JSON_PATH_EFFECTS;
+  if (out->full) {
+    if (!requestJSONBufferLock(17)) {
+      request->send(503, "application/json", F("{\"error\":3}"));
+      return;
+    }
+    JsonObject lDoc = doc.to<JsonObject>();
+    JsonObject state = lDoc.createNestedObject("state");
+    serializeState(state);
+    JsonObject info = lDoc.createNestedObject("info");
+    serializeInfo(info);
+    out->stateInfo.reset(new JsonOutBuffer());
+    bool ok = out->stateInfo->serialize(1); // without closing brace
+    releaseJSONBufferLock();
+    if (!ok) {
+      request->send(503, "application/json", F("{\"error\":3}")); // out of memory
+      return;
+    }
+    out->head = F(",\"effects\":[");
+  } else {
+    out->head = "[";
+  }
+  request->send(request->beginChunkedResponse("application/json", [out](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+    return out->fill(buffer, maxLen);
+  }));
+}
+
+/*
+ * Conditional GET for /json/state, /json/info and /json/si: the ETag is derived from stateVersion, so unchanged
+ * state is answered with 304 (or the cached last response) without the JSON buffer lock. Info (and state while
+ * nightlight counts down) changes continuously, it is considered current for JSON_INFO_MAX_AGE.
+ * The cache buffer is reused for the next response unless it is still being sent.
+ */
+#define JSON_INFO_MAX_AGE 5000 // ms
+static std::shared_ptr<JsonOutBuffer> jsonStateCache; // last serialized state/info response
+static char jsonStateCacheTag[32] = "";               // ETag of jsonStateCache
+
+static void getJsonETag(char *tag, byte subJson)
+{
+  static uint16_t bootId = 0; // tags from before a reboot must not match
+  while (!bootId) bootId = random(0x10000);
+  if (subJson == JSON_PATH_STATE && !nightlightActive) sprintf_P(tag, PSTR("\"%04x-%u-%u\""), bootId, subJson, stateVersion);
+  else sprintf_P(tag, PSTR("\"%04x-%u-%u-%lu\""), bootId, subJson, stateVersion, millis() / JSON_INFO_MAX_AGE);
+}
+
+static void serveJsonOut(AsyncWebServerRequest* request, std::shared_ptr<JsonOutBuffer> out, const char *etag)
+{
+  AsyncWebServerResponse *response = request->beginResponse("application/json", out->length(), [out](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+    return out->fill(buffer, maxLen, index);
+  });
+  response->addHeader(F("ETag"), etag);
+  request->send(response);
 }
 
 void serveJson(AsyncWebServerRequest* request)
@@ -1030,42 +1456,72 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
 
+  if (subJson == JSON_PATH_FXDATA && serveJsonCache(request, 0)) return;
+  if (subJson == JSON_PATH_PALETTES) {
+    int page = request->hasParam("page") ? request->getParam("page")->value().toInt() : 0;
+    if (page >= 0 && page <= getPaletteMaxPage() && serveJsonCache(request, page + 1)) return;
+  }
+
+  if (subJson == JSON_PATH_EFFECTS || subJson == JSON_PATH_FXDATA || subJson == 0) {
+    serveModeList(request, subJson);
+    return;
+  }
+
+  char etag[32] = "";
+  if (subJson == JSON_PATH_STATE || subJson == JSON_PATH_INFO || subJson == JSON_PATH_STATE_INFO) {
+    getJsonETag(etag, subJson);
+    if (etagMatches(request, etag)) {
+      AsyncWebServerResponse *response = request->beginResponse(304);
+      response->addHeader(F("ETag"), etag);
+      request->send(response);
+      return;
+    }
+    if (jsonStateCache && !strcmp(etag, jsonStateCacheTag)) {
+      serveJsonOut(request, jsonStateCache, etag);
+      return;
+    }
+  }
+
   if (!requestJSONBufferLock(17)) {
     request->send(503, "application/json", F("{\"error\":3}"));
     return;
   }
-  AsyncJsonResponse *response = new AsyncJsonResponse(&doc, subJson==JSON_PATH_FXDATA || subJson==JSON_PATH_EFFECTS); // will clear and convert JsonDocument into JsonArray if necessary
+  if (etag[0]) { // serialized into the cache, the lock is released before sending
+    JsonObject lDoc = doc.to<JsonObject>();
+    if (subJson != JSON_PATH_INFO) {
+      JsonObject state = subJson == JSON_PATH_STATE ? lDoc : lDoc.createNestedObject("state");
+      serializeState(state);
+    }
+    if (subJson != JSON_PATH_STATE) {
+      JsonObject info = subJson == JSON_PATH_INFO ? lDoc : lDoc.createNestedObject("info");
+      serializeInfo(info);
+    }
+    jsonStateCacheTag[0] = 0;
+    if (!jsonStateCache || jsonStateCache.use_count() > 1) jsonStateCache = std::make_shared<JsonOutBuffer>(); // old one is still sent
+    bool ok = jsonStateCache->serialize();
+    releaseJSONBufferLock();
+    if (!ok) {
+      jsonStateCache.reset();
+      request->send(503, "application/json", F("{\"error\":3}")); // out of memory
+      return;
+    }
+    strcpy(jsonStateCacheTag, etag);
+    serveJsonOut(request, jsonStateCache, etag);
+    return;
+  }
+
+  AsyncJsonResponse *response = new AsyncJsonResponse(&doc); // will clear and convert JsonDocument into JsonObject
 
   JsonVariant lDoc = response->getRoot();
 
   switch (subJson)
   {
-    case JSON_PATH_STATE:
-      serializeState(lDoc); break;
-    case JSON_PATH_INFO:
-      serializeInfo(lDoc); break;
     case JSON_PATH_NODES:
       serializeNodes(lDoc); break;
     case JSON_PATH_PALETTES:
       serializePalettes(lDoc, request->hasParam("page") ? request->getParam("page")->value().toInt() : 0); break;
-    case JSON_PATH_EFFECTS:
-      serializeModeNames(lDoc); break;
-    case JSON_PATH_FXDATA:
-      serializeModeData(lDoc); break;
     case JSON_PATH_NETWORKS:
       serializeNetworks(lDoc); break;
-    default: //all
-      JsonObject state = lDoc.createNestedObject("state");
-      serializeState(state);
-      JsonObject info = lDoc.createNestedObject("info");
-      serializeInfo(info);
-      if (subJson != JSON_PATH_STATE_INFO)
-      {
-        JsonArray effects = lDoc.createNestedArray(F("effects"));
-        serializeModeNames(effects); // remove WLED-SR extensions from effect names
-        lDoc[F("palettes")] = serialized((const __FlashStringHelper*)JSON_palette_names);
-      }
-      //lDoc["m"] = lDoc.memoryUsage(); // JSON buffer usage, for remote debugging
   }
 
   DEBUG_PRINTF("JSON buffer size: %u for request: %d\n", lDoc.memoryUsage(), subJson);
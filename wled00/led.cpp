@@ -109,10 +109,12 @@ void stateUpdated(byte callMode) {
     //set flag to update ws and mqtt
     interfaceUpdateCallMode = callMode;
     stateChanged = false;
+    stateVersion++;
   } else {
     if (nightlightActive && !nightlightActiveOld && callMode != CALL_MODE_NOTIFICATION && callMode != CALL_MODE_NO_NOTIFY) {
       notify(CALL_MODE_NIGHTLIGHT);
       interfaceUpdateCallMode = CALL_MODE_NIGHTLIGHT;
+      stateVersion++;
     }
   }
 
@@ -161,6 +163,7 @@ void stateUpdated(byte callMode) {
 
 void updateInterfaces(uint8_t callMode)
 {
+  stateVersion++; // also covers changes not passing stateUpdated()
   sendDataWs();
   lastInterfaceUpdate = millis();
   if (callMode == CALL_MODE_WS_SEND) return;
@@ -0,0 +1,120 @@
+#ifndef WLED_PIXEL_STREAM_H
+#define WLED_PIXEL_STREAM_H
+
+/*
+ * Decoder for binary bulk pixel data
+ *
+ * Layout: [seg, format, start hi, start lo] followed by the pixel data. Format bits:
+ *   PIXEL_FMT_W        4 bytes per color (r, g, b, w) instead of 3
+ *   PIXEL_FMT_RLE      each pixel is preceded by a run length (1-255)
+ *   PIXEL_FMT_PALETTE  a color table follows the header ([n] (0 = 256) and n colors), pixels are 1 byte indexes
+ * Data may be fed in arbitrary pieces (HTTP body chunks, file reads), decoded pixels are handed to a callback.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PIXEL_FMT_W        0x01
+#define PIXEL_FMT_RLE      0x02
+#define PIXEL_FMT_PALETTE  0x04
+#define PIXEL_FMT_MASK     0x07
+
+#define PIXEL_HEADER_SIZE  4
+
+class PixelStream {
+  public:
+    // pixel of segment seg (as in the header) at index, return false if out of range to stop decoding
+    typedef bool (*Setter)(uint8_t seg, uint16_t index, uint32_t color, void *ctx);
+
+    PixelStream() { begin(); }
+
+    void begin() {
+      _stage = STAGE_HEADER;
+      _have = 0;
+      _palSize = 0;
+      _count = 0;
+    }
+
+    // returns false once the data is invalid (further data is ignored)
+    bool feed(const uint8_t *data, size_t len, Setter set, void *ctx) {
+      for (size_t i = 0; i < len && _stage != STAGE_ERROR; i++) {
+        _buf[_have++] = data[i];
+        switch (_stage) {
+          case STAGE_HEADER:
+            if (_have < PIXEL_HEADER_SIZE) break;
+            _seg   = _buf[0];
+            _fmt   = _buf[1];
+            _index = (_buf[2] << 8) | _buf[3];
+            _have  = 0;
+            if (_fmt & ~PIXEL_FMT_MASK) _stage = STAGE_ERROR;
+            else _stage = (_fmt & PIXEL_FMT_PALETTE) ? STAGE_PAL_SIZE : STAGE_PIXELS;
+            break;
+          case STAGE_PAL_SIZE:
+            _palSize = _buf[0] ? _buf[0] : 256;
+            _palFill = 0;
+            _have = 0;
+            _stage = STAGE_PAL;
+            break;
+          case STAGE_PAL:
+            if (_have < colorSize()) break;
+            _pal[_palFill++] = color(_buf);
+            _have = 0;
+            if (_palFill == _palSize) _stage = STAGE_PIXELS;
+            break;
+          case STAGE_PIXELS: {
+            size_t rle = (_fmt & PIXEL_FMT_RLE) ? 1 : 0;
+            if (_have < rle + itemSize()) break;
+            size_t run = rle ? _buf[0] : 1;
+            uint32_t c;
+            if (_fmt & PIXEL_FMT_PALETTE) {
+              if (_buf[rle] >= _palSize) { _stage = STAGE_ERROR; break; }
+              c = _pal[_buf[rle]];
+            } else {
+              c = color(_buf + rle);
+            }
+            _have = 0;
+            if (!run) { _stage = STAGE_ERROR; break; }
+            for (size_t r = 0; r < run; r++, _index++) {
+              if (_index > 0xFFFF || !set(_seg, _index, c, ctx)) { _stage = STAGE_ERROR; break; }
+              _count++;
+            }
+            break;
+          }
+          default: break;
+        }
+      }
+      return _stage != STAGE_ERROR;
+    }
+
+    // true if all data fed so far was valid and ended on a pixel boundary
+    bool complete() const { return _stage == STAGE_PIXELS && _have == 0; }
+    bool failed()   const { return _stage == STAGE_ERROR; }
+    bool headerDone() const { return _stage > STAGE_HEADER; }
+    uint8_t  segment() const { return _seg; }
+    uint32_t count()   const { return _count; } // pixels set
+
+  private:
+    enum { STAGE_HEADER, STAGE_PAL_SIZE, STAGE_PAL, STAGE_PIXELS, STAGE_ERROR };
+
+    size_t colorSize() const { return (_fmt & PIXEL_FMT_W) ? 4 : 3; }
+    size_t itemSize()  const { return (_fmt & PIXEL_FMT_PALETTE) ? 1 : colorSize(); }
+
+    // same layout as RGBW32()
+    uint32_t color(const uint8_t *p) const {
+      return ((uint32_t)((_fmt & PIXEL_FMT_W) ? p[3] : 0) << 24) | ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    }
+
+    uint32_t _pal[256];
+    uint32_t _index;
+    uint32_t _count;
+    uint16_t _palSize;
+    uint16_t _palFill;
+    uint8_t  _buf[PIXEL_HEADER_SIZE + 1];
+    uint8_t  _have;
+    uint8_t  _stage;
+    uint8_t  _seg;
+    uint8_t  _fmt;
+};
+
+#endif
@@ -0,0 +1,173 @@
+#include "wled.h"
+
+/*
+ * Binary bulk pixel upload (POST /json/pixels, WebSocket opcode 0x08) and named frames
+ *
+ * Data is decoded by PixelStream (see pixel_stream.h for the layout) and written into the segment as it arrives,
+ * without a JSON document. Like "i" in the JSON API, the segment is frozen and pixels not set are black.
+ * Segment 255 applies to all selected segments. On 2D segments pixels are numbered row by row.
+ * Frames are stored as received in /frames/<name>.bin and can be applied again by name
+ * (POST /json/pixels?frame=<name> without body, WebSocket opcode 0x09 or "frame" in the JSON API).
+ */
+
+#define PIXEL_ALL_SEGMENTS  255
+#define PIXEL_FRAME_NAME_LEN 24
+
+struct PixelUpload {
+  PixelStream stream;
+  bool started;   // brightness and transition handled
+  bool saving;    // request->_tempFile is open
+  bool denied;    // storing a frame requires the settings PIN
+};
+
+static bool setSegmentPixel(Segment &seg, uint16_t index, uint32_t color)
+{
+  if (seg.is2D()) {
+    uint16_t w = seg.virtualWidth();
+    if (index >= w * seg.virtualHeight()) return false;
+    if (!seg.freeze) { seg.freeze = true; seg.fill(BLACK); } // freeze and init to black
+    seg.setPixelColorXY(index % w, index / w, color);
+  } else {
+    if (index >= seg.virtualLength()) return false;
+    if (!seg.freeze) { seg.freeze = true; seg.fill(BLACK); }
+    seg.setPixelColor(index, color);
+  }
+  return true;
+}
+
+static bool setPixel(uint8_t segId, uint16_t index, uint32_t color, void *ctx)
+{
+  PixelUpload *up = (PixelUpload*)ctx;
+  if (!up->started) {
+    // set brightness immediately and disable transition
+    transitionDelayTemp = 0;
+    jsonTransitionOnce = true;
+    strip.setBrightness(scaledBri(bri), true);
+    up->started = true;
+  }
+  color = gamma32(color);
+  if (segId != PIXEL_ALL_SEGMENTS) {
+    if (segId >= strip.getSegmentsNum()) return false;
+    return setSegmentPixel(strip.getSegment(segId), index, color);
+  }
+  bool set = false;
+  for (size_t s = 0; s < strip.getSegmentsNum(); s++) {
+    Segment &seg = strip.getSegment(s);
+    if (seg.isActive() && seg.isSelected()) set |= setSegmentPixel(seg, index, color); // segments may differ in length
+  }
+  return set;
+}
+
+static PixelUpload* newPixelUpload()
+{
+  PixelUpload *up = (PixelUpload*)malloc(sizeof(PixelUpload)); // released with free() (request->_tempObject)
+  if (!up) return nullptr;
+  up->stream.begin();
+  up->started = up->saving = up->denied = false;
+  return up;
+}
+
+static void endPixelUpload(PixelUpload *up)
+{
+  if (!up->stream.count()) return;
+  strip.trigger(); // force segment update
+  stateUpdated(CALL_MODE_DIRECT_CHANGE);
+}
+
+// file name from user supplied name, false if invalid
+static bool getFramePath(char *path, const char *name)
+{
+  size_t len = strlen(name);
+  if (!len || len > PIXEL_FRAME_NAME_LEN) return false;
+  for (size_t i = 0; i < len; i++) if (!isalnum(name[i]) && name[i] != '-' && name[i] != '_') return false;
+  sprintf_P(path, PSTR("/frames/%s.bin"), name);
+  return true;
+}
+
+bool applyPixelData(const uint8_t *data, size_t len)
+{
+  PixelUpload *up = newPixelUpload();
+  if (!up) return false;
+  bool ok = up->stream.feed(data, len, setPixel, up) && up->stream.complete();
+  endPixelUpload(up);
+  free(up);
+  return ok;
+}
+
+bool applyPixelFrame(const char *name)
+{
+  char path[48];
+  if (!getFramePath(path, name)) return false;
+  File f = WLED_FS.open(path, "r");
+  if (!f) return false;
+  PixelUpload *up = newPixelUpload();
+  if (!up) { f.close(); return false; }
+  uint8_t buf[256];
+  size_t len;
+  while ((len = f.read(buf, sizeof(buf))) > 0 && up->stream.feed(buf, len, setPixel, up));
+  f.close();
+  bool ok = up->stream.complete();
+  endPixelUpload(up);
+  free(up);
+  return ok;
+}
+
+// body of POST /json/pixels, decoded chunk by chunk, stored if "frame" is given
+void handlePixelUploadBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)
+{
+  PixelUpload *up = (PixelUpload*)request->_tempObject;
+  if (!index && !up) {
+    up = newPixelUpload();
+    if (!up) return;
+    request->_tempObject = up;
+    AsyncWebParameter *frame = request->getParam(F("frame"));
+    char path[48];
+    if (frame && getFramePath(path, frame->value().c_str())) {
+      if (!correctPIN) {
+        up->denied = true; // nothing applied, rejected when the request completes
+        return;
+      }
+      WLED_FS.mkdir("/frames");
+      request->_tempFile = WLED_FS.open(path, "w");
+      up->saving = (bool)request->_tempFile;
+    }
+  }
+  if (!up || up->denied) return;
+  if (up->saving && request->_tempFile.write(data, len) != len) {
+    request->_tempFile.close();
+    up->saving = false;
+  }
+  up->stream.feed(data, len, setPixel, up);
+}
+
+// end of POST /json/pixels
+void servePixelUpload(AsyncWebServerRequest *request)
+{
+  PixelUpload *up = (PixelUpload*)request->_tempObject;
+  AsyncWebParameter *frame = request->getParam(F("frame"));
+  if (!up) { // no body: apply stored frame
+    if (frame && request->contentLength() == 0) {
+      if (applyPixelFrame(frame->value().c_str())) request->send(200, "application/json", F("{\"success\":true}"));
+      else request->send(404, "application/json", F("{\"error\":12}")); // ERR_FS_PLOAD
+      return;
+    }
+    if (request->contentLength()) request->send(503, "application/json", F("{\"error\":3}")); // ERR_NOBUF
+    else                          request->send(400, "application/json", F("{\"error\":9}")); // ERR_JSON
+    return;
+  }
+  if (up->denied) {
+    request->send(403, "application/json", F("{\"error\":1}")); // ERR_DENIED
+    return;
+  }
+  endPixelUpload(up);
+  bool ok = up->stream.complete();
+  if (up->saving) {
+    request->_tempFile.close();
+    if (!ok) { // do not keep invalid frames
+      char path[48];
+      if (getFramePath(path, frame->value().c_str())) WLED_FS.remove(path);
+    }
+  }
+  if (ok) request->send(200, "application/json", F("{\"success\":true}"));
+  else    request->send(400, "application/json", F("{\"error\":9}")); // ERR_JSON
+}
@@ -110,8 +110,11 @@ void ESPAsyncE131::parsePacket(AsyncUDPPacket _packet) {
 	if (protocol == P_ARTNET) {
 		if (memcmp(sbuff->art_id, ESPAsyncE131::ART_ID, sizeof(sbuff->art_id)))
 			error = true; //not "Art-Net"
-		if (sbuff->art_opcode != ARTNET_OPCODE_OPDMX && sbuff->art_opcode != ARTNET_OPCODE_OPPOLL)
-			error = true; //not a DMX or poll packet
+		if (sbuff->art_opcode != ARTNET_OPCODE_OPDMX && sbuff->art_opcode != ARTNET_OPCODE_OPPOLL && sbuff->art_opcode != ARTNET_OPCODE_OPSYNC)
+			error = true; //not a DMX, poll or sync packet
+	} else if (htonl(sbuff->root_vector) == ESPAsyncE131::VECTOR_ROOT_EXTENDED) { //E1.31 synchronization packet
+		if (htonl(sbuff->sync_vector) != ESPAsyncE131::VECTOR_EXTENDED_SYNC)
+			error = true;
 	} else { //E1.31 error handling
 		if (htonl(sbuff->root_vector) != ESPAsyncE131::VECTOR_ROOT)
 			error = true;
@@ -129,6 +132,6 @@ void ESPAsyncE131::parsePacket(AsyncUDPPacket _packet) {
   }
 
   if (!error) {
-    _callback(sbuff, _packet.remoteIP(), protocol);
+    _callback(sbuff, _packet.remoteIP(), protocol, _packet.length());
   }
 }
\ No newline at end of file
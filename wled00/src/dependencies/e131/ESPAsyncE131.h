@@ -59,6 +59,7 @@ typedef struct ip_addr ip4_addr_t;
 #define ARTNET_OPCODE_OPDMX 0x5000
 #define ARTNET_OPCODE_OPPOLL 0x2000
 #define ARTNET_OPCODE_OPPOLLREPLY 0x2100
+#define ARTNET_OPCODE_OPSYNC 0x5200
 
 #define P_E131   0
 #define P_ARTNET 1
@@ -132,6 +133,14 @@ typedef union {
     uint8_t  art_data[512];
   } __attribute__((packed));
 
+  struct { //E1.31 synchronization packet
+    uint8_t  sync_header[40]; // root layer and frame flength, same as data packet
+    uint32_t sync_vector;
+    uint8_t  sync_sequence_number;
+    uint16_t sync_address;
+    uint16_t sync_reserved;
+  } __attribute__((packed));
+
   struct { //DDP Header
     uint8_t flags;
     uint8_t sequenceNum;
@@ -199,7 +208,7 @@ typedef union {
 } ArtPollReply;
 
 // new packet callback
-typedef void (*e131_packet_callback_function) (e131_packet_t* p, IPAddress clientIP, byte protocol);
+typedef void (*e131_packet_callback_function) (e131_packet_t* p, IPAddress clientIP, byte protocol, size_t len); // len: UDP payload length
 
 class ESPAsyncE131 {
  private:
@@ -207,7 +216,9 @@ class ESPAsyncE131 {
     static const uint8_t ACN_ID[];
 	  static const uint8_t ART_ID[];
     static const uint32_t VECTOR_ROOT = 4;
+    static const uint32_t VECTOR_ROOT_EXTENDED = 8;
     static const uint32_t VECTOR_FRAME = 2;
+    static const uint32_t VECTOR_EXTENDED_SYNC = 1;
     static const uint8_t VECTOR_DMP = 2;
 
     AsyncUDP        udp;        // AsyncUDP
@@ -228,30 +239,4 @@ class ESPAsyncE131 {
     bool begin(bool multicast, uint16_t port = E131_DEFAULT_PORT, uint16_t universe = 1, uint8_t n = 1);
 };
 
-// Class to track e131 package priority
-class E131Priority {
-  private:
-    uint8_t priority;
-    time_t setupTime;
-    uint8_t seconds;
-  
-  public:
-    E131Priority(uint8_t timeout=3) { 
-      seconds = timeout;
-      set(0);
-    };
-
-    // Set priority (+ remember time)
-    void set(uint8_t prio) {
-      setupTime = time(0);
-      priority = prio;
-    }
-
-    // Get priority (+ reset & return 0 if older timeout)
-    uint8_t get() {
-      if (time(0) > setupTime + seconds) priority = 0;
-      return priority;
-    }
-};
-
 #endif  // ESPASYNCE131_H_
\ No newline at end of file
@@ -9,24 +9,83 @@
 #define WLEDPACKETSIZE (41+(MAX_NUM_SEGMENTS*UDP_SEG_SIZE)+0)
 #define UDP_IN_MAXSIZE 1472
 #define PRESUMED_NETWORK_DELAY 3 //how many ms could it take on avg to reach the receiver? This will be added to transmitted times
+#define UDP_INGEST_MAX_PACKETS 32   //max. packets processed per handleNotifications() call
+#define UDP_INGEST_BUDGET_US 5000   //max. time spent receiving packets per handleNotifications() call
 
-void notify(byte callMode, bool followUp)
+/*
+ * Delta sync: instead of the full notifier packet only the byte ranges that changed since the last packet are sent.
+ * Keyframes are regular notifier packets with a trailer (sequence number, delta version, marker), so nodes
+ * not supporting deltas still receive the full state every now and then. Receivers keep the last keyframe as
+ * base, patch it with consecutive deltas and request a keyframe from the sender if a sequence number is missing.
+ *
+ * Delta packet: [0] UDP_DELTA_PACKET [1] version [2] sync groups [3-4] sequence [5] kind [6-7] full packet length
+ * followed by runs of [offset hi, offset lo, length, data...]
+ */
+#define UDP_DELTA_PACKET 6          //first byte of delta sync packets (unused by realtime protocols)
+#define UDP_DELTA_VERSION 1
+#define UDP_DELTA_HEADER 8
+#define UDP_DELTA_RUN_HEADER 3
+#define UDP_DELTA_TRAILER 4         //keyframe trailer: sequence hi, sequence lo, version, marker
+#define UDP_DELTA_MARKER 0xD5
+#define UDP_DELTA_DATA 0            //delta packet kinds
+#define UDP_DELTA_RESYNC 1
+#define UDP_DELTA_ALWAYS_FROM 24    //followUp, timebase and system time change with every packet, always included
+#define UDP_DELTA_ALWAYS_TO 35
+#define UDP_KEYFRAME_INTERVAL 10000 //ms, deltas are based on a keyframe at most this old
+#define UDP_KEYFRAME_TRAILING 1000  //ms after the last delta a keyframe is sent so lost deltas are not noticed only with the next change
+#define UDP_RESYNC_INTERVAL 500     //ms, min. time between resync requests and between keyframes sent on request
+
+// sender
+static byte *syncLastSent = nullptr;          //last packet sent (base of next delta), followed by scratch space for the delta
+static uint16_t syncSeq = 0;
+static unsigned long syncKeyframeTime = 0;
+static bool syncKeyframeDue = false;          //deltas were sent since the last keyframe
+static bool syncResyncRequested = false;
+// receiver: delta base per sender, so several nodes of a sync group can send deltas
+#ifndef UDP_SYNC_BASES
+  #ifdef ESP8266
+    #define UDP_SYNC_BASES 2
+  #else
+    #define UDP_SYNC_BASES 4
+  #endif
+#endif
+typedef struct SyncBase {
+  byte *data;                 //last state received from ip, patched by deltas
+  uint16_t len;               //0: no valid base
+  uint16_t seq;
+  IPAddress ip;
+  unsigned long lastUse;
+  unsigned long resyncSent;
+  bool used;                  //entry assigned to ip
+} SyncBase;
+static SyncBase syncBases[UDP_SYNC_BASES];
+
+/*
+ * Effect clock sync: followers measure their offset to the master with request/reply exchanges (see clock_sync.h)
+ * Packet: [0] UDP_CLOCK_PACKET [1] kind [2] sync groups [3-6] t1 [7-10] t2 [11-14] t3 [15-18] master effect time (ms) at t3
+ */
+#define UDP_CLOCK_PACKET 7           //first byte of clock sync packets
+#define UDP_CLOCK_REQUEST 0
+#define UDP_CLOCK_REPLY 1
+#define UDP_CLOCK_SIZE 19
+#define CLOCK_SYNC_INTERVAL 1000     //ms between requests while locked
+#define CLOCK_SYNC_FAST_INTERVAL 250 //ms between requests while acquiring
+#define CLOCK_SYNC_TIMEOUT 10000     //ms without reply until the master is searched by broadcast again
+
+static IPAddress clockMasterIP;               //0.0.0.0 if unknown, requests are broadcast
+static unsigned long clockRequestTime = 0;
+static unsigned long clockReplyTime = 0;
+static uint32_t clockRequestUs = 0;           //t1 of outstanding request, 0 if none
+
+// effect time (strip.now) in us, wraps at 32 bit like micros()
+static inline uint32_t effectTimeUs() { return micros() + strip.timebase * 1000UL; }
+
+static inline void writeClockTime(byte *p, uint32_t t) { p[0] = t >> 24; p[1] = t >> 16; p[2] = t >> 8; p[3] = t; }
+static inline uint32_t readClockTime(const byte *p) { return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3]; }
+
+static void buildNotifierPacket(byte *udpOut, byte callMode, bool followUp)
 {
-  if (!udpConnected) return;
-  if (!syncGroups) return;
-  switch (callMode)
-  {
-    case CALL_MODE_INIT:          return;
-    case CALL_MODE_DIRECT_CHANGE: if (!notifyDirect) return; break;
-    case CALL_MODE_BUTTON:        if (!notifyButton) return; break;
-    case CALL_MODE_BUTTON_PRESET: if (!notifyButton) return; break;
-    case CALL_MODE_NIGHTLIGHT:    if (!notifyDirect) return; break;
-    case CALL_MODE_HUE:           if (!notifyHue)    return; break;
-    case CALL_MODE_PRESET_CYCLE:  if (!notifyDirect) return; break;
-    case CALL_MODE_ALEXA:         if (!notifyAlexa)  return; break;
-    default: return;
-  }
-  byte udpOut[WLEDPACKETSIZE];
+  memset(udpOut, 0, WLEDPACKETSIZE); // unused segment slots must not differ between packets
   Segment& mainseg = strip.getMainSegment();
   udpOut[0] = 0; //0: wled notifier protocol 1: WARLS protocol
   udpOut[1] = callMode;
@@ -137,13 +196,106 @@ void notify(byte callMode, bool followUp)
 
   //uint16_t offs = SEG_OFFSET;
   //next value to be added has index: udpOut[offs + 0]
+}
 
+static void broadcastNotifierPacket(const byte *buf, size_t len)
+{
   IPAddress broadcastIp;
   broadcastIp = ~uint32_t(Network.subnetMask()) | uint32_t(Network.gatewayIP());
 
   notifierUdp.beginPacket(broadcastIp, udpPort);
-  notifierUdp.write(udpOut, WLEDPACKETSIZE);
+  notifierUdp.write(buf, len);
   notifierUdp.endPacket();
+}
+
+// udpOut must have room for WLEDPACKETSIZE + UDP_DELTA_TRAILER bytes
+static void sendSyncKeyframe(byte *udpOut)
+{
+  if (!syncLastSent) {
+    syncLastSent = (byte*)malloc(2 * WLEDPACKETSIZE);
+    if (!syncLastSent) { broadcastNotifierPacket(udpOut, WLEDPACKETSIZE); return; } // send plain packet
+  }
+  syncSeq++;
+  udpOut[WLEDPACKETSIZE  ] = syncSeq >> 8;
+  udpOut[WLEDPACKETSIZE+1] = syncSeq & 0xFF;
+  udpOut[WLEDPACKETSIZE+2] = UDP_DELTA_VERSION;
+  udpOut[WLEDPACKETSIZE+3] = UDP_DELTA_MARKER;
+  broadcastNotifierPacket(udpOut, WLEDPACKETSIZE + UDP_DELTA_TRAILER);
+  memcpy(syncLastSent, udpOut, WLEDPACKETSIZE);
+  syncKeyframeTime = millis();
+  syncKeyframeDue = false;
+  syncResyncRequested = false;
+}
+
+static inline bool syncByteChanged(const byte *udpOut, size_t i)
+{
+  return (i >= UDP_DELTA_ALWAYS_FROM && i <= UDP_DELTA_ALWAYS_TO) || udpOut[i] != syncLastSent[i];
+}
+
+// returns false if a keyframe needs to be sent instead
+static bool sendSyncDelta(const byte *udpOut)
+{
+  if (!syncLastSent || syncResyncRequested || millis() - syncKeyframeTime > UDP_KEYFRAME_INTERVAL) return false;
+
+  byte *delta = syncLastSent + WLEDPACKETSIZE;
+  uint16_t seq = syncSeq + 1;
+  delta[0] = UDP_DELTA_PACKET;
+  delta[1] = UDP_DELTA_VERSION;
+  delta[2] = syncGroups;
+  delta[3] = seq >> 8;
+  delta[4] = seq & 0xFF;
+  delta[5] = UDP_DELTA_DATA;
+  delta[6] = WLEDPACKETSIZE >> 8;
+  delta[7] = WLEDPACKETSIZE & 0xFF;
+  size_t pos = UDP_DELTA_HEADER;
+  for (size_t i = 0; i < WLEDPACKETSIZE; i++) {
+    if (!syncByteChanged(udpOut, i)) continue;
+    // extend run over short stretches of unchanged bytes, a new run would cost as much
+    size_t last = i;
+    for (size_t j = i+1; j < WLEDPACKETSIZE && j - i < 255 && j - last <= UDP_DELTA_RUN_HEADER; j++) {
+      if (syncByteChanged(udpOut, j)) last = j;
+    }
+    size_t runLen = last - i + 1;
+    if (pos + UDP_DELTA_RUN_HEADER + runLen >= WLEDPACKETSIZE) return false; // no gain over full packet
+    delta[pos++] = i >> 8;
+    delta[pos++] = i & 0xFF;
+    delta[pos++] = runLen;
+    memcpy(delta + pos, udpOut + i, runLen);
+    pos += runLen;
+    i = last;
+  }
+  broadcastNotifierPacket(delta, pos);
+  memcpy(syncLastSent, udpOut, WLEDPACKETSIZE);
+  syncSeq = seq;
+  syncKeyframeDue = true;
+  return true;
+}
+
+void notify(byte callMode, bool followUp)
+{
+  if (!udpConnected) return;
+  if (!syncGroups) return;
+  switch (callMode)
+  {
+    case CALL_MODE_INIT:          return;
+    case CALL_MODE_DIRECT_CHANGE: if (!notifyDirect) return; break;
+    case CALL_MODE_BUTTON:        if (!notifyButton) return; break;
+    case CALL_MODE_BUTTON_PRESET: if (!notifyButton) return; break;
+    case CALL_MODE_NIGHTLIGHT:    if (!notifyDirect) return; break;
+    case CALL_MODE_HUE:           if (!notifyHue)    return; break;
+    case CALL_MODE_PRESET_CYCLE:  if (!notifyDirect) return; break;
+    case CALL_MODE_ALEXA:         if (!notifyAlexa)  return; break;
+    default: return;
+  }
+  byte udpOut[WLEDPACKETSIZE + UDP_DELTA_TRAILER];
+  buildNotifierPacket(udpOut, callMode, followUp);
+
+  if (!syncDelta) {
+    if (syncLastSent) { free(syncLastSent); syncLastSent = nullptr; }
+    broadcastNotifierPacket(udpOut, WLEDPACKETSIZE);
+  } else if (followUp || !sendSyncDelta(udpOut)) {
+    sendSyncKeyframe(udpOut); // retransmissions are meant for reliability, send full state
+  }
   notificationSentCallMode = callMode;
   notificationSentTime = millis();
   notificationCount = followUp ? notificationCount + 1 : 0;
@@ -210,27 +362,251 @@ void sendTPM2Ack() {
 }
 
 
-void handleNotifications()
+// applies WLED notifier packet, segMask selects the segment records that need to be applied
+static void applyNotification(const byte *udpIn, uint32_t segMask)
 {
-  IPAddress localIP;
+  //compatibilityVersionByte:
+  byte version = udpIn[11];
+
+  // if we are not part of any sync group ignore message
+  if (version < 9 || version > 199) {
+    // legacy senders are treated as if sending in sync group 1 only
+    if (!(receiveGroups & 0x01)) return;
+  } else if (!(receiveGroups & udpIn[36])) return;
+
+  bool someSel = (receiveNotificationBrightness || receiveNotificationColor || receiveNotificationEffects);
+
+  //apply colors from notification to main segment, only if not syncing full segments
+  if ((receiveNotificationColor || !someSel) && (version < 11 || !receiveSegmentOptions)) {
+    // primary color, only apply white if intented (version > 0)
+    strip.setColor(0, RGBW32(udpIn[3], udpIn[4], udpIn[5], (version > 0) ? udpIn[10] : 0));
+    if (version > 1) {
+      strip.setColor(1, RGBW32(udpIn[12], udpIn[13], udpIn[14], udpIn[15])); // secondary color
+    }
+    if (version > 6) {
+      strip.setColor(2, RGBW32(udpIn[20], udpIn[21], udpIn[22], udpIn[23])); // tertiary color
+      if (version > 9 && version < 200 && udpIn[37] < 255) { // valid CCT/Kelvin value
+        uint16_t cct = udpIn[38];
+        if (udpIn[37] > 0) { //Kelvin
+          cct |= (udpIn[37] << 8);
+        }
+        strip.setCCT(cct);
+      }
+    }
+  }
 
-  //send second notification if enabled
-  if(udpConnected && (notificationCount < udpNumRetries) && ((millis()-notificationSentTime) > 250)){
-    notify(notificationSentCallMode,true);
+  bool timebaseUpdated = false;
+  //apply effects from notification
+  bool applyEffects = (receiveNotificationEffects || !someSel);
+  if (version < 200)
+  {
+    if (applyEffects && currentPlaylist >= 0) unloadPlaylist();
+    if (version > 10 && (receiveSegmentOptions || receiveSegmentBounds)) {
+      uint8_t numSrcSegs = udpIn[39];
+      for (size_t i = 0; i < numSrcSegs; i++) {
+        if (i < 32 && !(segMask & (1UL << i))) continue; // segment unchanged since last delta
+        uint16_t ofs = 41 + i*udpIn[40]; //start of segment offset byte
+        uint8_t id = udpIn[0 +ofs];
+        if (id > strip.getSegmentsNum()) break;
+
+        Segment& selseg = strip.getSegment(id);
+        if (!selseg.isActive() || !selseg.isSelected()) continue; //do not apply to non selected segments
+
+        uint16_t startY = 0, start  = (udpIn[1+ofs] << 8 | udpIn[2+ofs]);
+        uint16_t stopY  = 1, stop   = (udpIn[3+ofs] << 8 | udpIn[4+ofs]);
+        uint16_t offset = (udpIn[7+ofs] << 8 | udpIn[8+ofs]);
+        if (!receiveSegmentOptions) {
+          selseg.setUp(start, stop, selseg.grouping, selseg.spacing, offset, startY, stopY);
+          continue;
+        }
+        //for (size_t j = 1; j<4; j++) selseg.setOption(j, (udpIn[9 +ofs] >> j) & 0x01); //only take into account mirrored, on, reversed; ignore selected
+        selseg.options = (selseg.options & 0x0071U) | (udpIn[9 +ofs] & 0x0E); // ignore selected, freeze, reset & transitional
+        selseg.setOpacity(udpIn[10+ofs]);
+        if (applyEffects) {
+          strip.setMode(id,  udpIn[11+ofs]);
+          selseg.speed     = udpIn[12+ofs];
+          selseg.intensity = udpIn[13+ofs];
+          selseg.palette   = udpIn[14+ofs];
+        }
+        if (receiveNotificationColor || !someSel) {
+          selseg.setColor(0, RGBW32(udpIn[15+ofs],udpIn[16+ofs],udpIn[17+ofs],udpIn[18+ofs]));
+          selseg.setColor(1, RGBW32(udpIn[19+ofs],udpIn[20+ofs],udpIn[21+ofs],udpIn[22+ofs]));
+          selseg.setColor(2, RGBW32(udpIn[23+ofs],udpIn[24+ofs],udpIn[25+ofs],udpIn[26+ofs]));
+          selseg.setCCT(udpIn[27+ofs]);
+        }
+        if (version > 11) {
+          // when applying synced options ignore selected as it may be used as indicator of which segments to sync
+          // freeze, reset & transitional should never be synced
+          selseg.options = (selseg.options & 0x0071U) | (udpIn[28+ofs]<<8) | (udpIn[9 +ofs] & 0x8E); // ignore selected, freeze, reset & transitional
+          if (applyEffects) {
+            selseg.custom1 = udpIn[29+ofs];
+            selseg.custom2 = udpIn[30+ofs];
+            selseg.custom3 = udpIn[31+ofs] & 0x1F;
+            selseg.check1  = (udpIn[31+ofs]>>5) & 0x1;
+            selseg.check1  = (udpIn[31+ofs]>>6) & 0x1;
+            selseg.check1  = (udpIn[31+ofs]>>7) & 0x1;
+          }
+          startY = (udpIn[32+ofs] << 8 | udpIn[33+ofs]);
+          stopY  = (udpIn[34+ofs] << 8 | udpIn[35+ofs]);
+        }
+        if (receiveSegmentBounds) {
+          selseg.setUp(start, stop, udpIn[5+ofs], udpIn[6+ofs], offset, startY, stopY);
+        } else {
+          selseg.setUp(selseg.start, selseg.stop, udpIn[5+ofs], udpIn[6+ofs], selseg.offset, selseg.startY, selseg.stopY);
+        }
+      }
+      stateChanged = true;
+    }
+
+    // simple effect sync, applies to all selected segments
+    if (applyEffects && (version < 11 || !receiveSegmentOptions)) {
+      for (size_t i = 0; i < strip.getSegmentsNum(); i++) {
+        Segment& seg = strip.getSegment(i);
+        if (!seg.isActive() || !seg.isSelected()) continue;
+        seg.setMode(udpIn[8]);
+        seg.speed = udpIn[9];
+        if (version > 2) seg.intensity = udpIn[16];
+        if (version > 4) seg.setPalette(udpIn[19]);
+      }
+      stateChanged = true;
+    }
+
+    // followers of the clock sync master keep their own, more accurate timebase
+    if (applyEffects && version > 5 && !(clockSyncMode == CLOCK_SYNC_FOLLOWER && clockSync.isLocked())) {
+      uint32_t t = (udpIn[25] << 24) | (udpIn[26] << 16) | (udpIn[27] << 8) | (udpIn[28]);
+      t += PRESUMED_NETWORK_DELAY; //adjust trivially for network delay
+      t -= millis();
+      strip.timebase = t;
+      timebaseUpdated = true;
+    }
   }
 
-  if (e131NewData && millis() - strip.getLastShow() > 15)
+  //adjust system time, but only if sender is more accurate than self
+  if (version > 7 && version < 200)
   {
-    e131NewData = false;
-    strip.show();
+    Toki::Time tm;
+    tm.sec = (udpIn[30] << 24) | (udpIn[31] << 16) | (udpIn[32] << 8) | (udpIn[33]);
+    tm.ms = (udpIn[34] << 8) | (udpIn[35]);
+    if (udpIn[29] > toki.getTimeSource()) { //if sender's time source is more accurate
+      toki.adjust(tm, PRESUMED_NETWORK_DELAY); //adjust trivially for network delay
+      uint8_t ts = TOKI_TS_UDP;
+      if (udpIn[29] > 99) ts = TOKI_TS_UDP_NTP;
+      else if (udpIn[29] >= TOKI_TS_SEC) ts = TOKI_TS_UDP_SEC;
+      toki.setTime(tm, ts);
+    } else if (timebaseUpdated && toki.getTimeSource() > 99) { //if we both have good times, get a more accurate timebase
+      Toki::Time myTime = toki.getTime();
+      uint32_t diff = toki.msDifference(tm, myTime);
+      strip.timebase -= PRESUMED_NETWORK_DELAY; //no need to presume, use difference between NTP times at send and receive points
+      if (toki.isLater(tm, myTime)) {
+        strip.timebase += diff;
+      } else {
+        strip.timebase -= diff;
+      }
+    }
   }
 
-  //unlock strip when realtime UDP times out
-  if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
+  if (version > 3)
+  {
+    transitionDelayTemp = ((udpIn[17] << 0) & 0xFF) + ((udpIn[18] << 8) & 0xFF00);
+  }
 
-  //receive UDP notifications
-  if (!udpConnected) return;
+  nightlightActive = udpIn[6];
+  if (nightlightActive) nightlightDelayMins = udpIn[7];
+
+  if (receiveNotificationBrightness || !someSel) bri = udpIn[2];
+  stateUpdated(CALL_MODE_NOTIFICATION);
+}
+
+static bool isSyncKeyframe(const byte *udpIn, uint16_t len)
+{
+  if (len < 41 + UDP_DELTA_TRAILER || udpIn[len-1] != UDP_DELTA_MARKER || udpIn[len-2] != UDP_DELTA_VERSION) return false;
+  return udpIn[11] > 11 && len - UDP_DELTA_TRAILER >= 41 + udpIn[39]*udpIn[40];
+}
+
+// base of sender, if create is set a new (or least recently used) entry is assigned if there is none
+static SyncBase* getSyncBase(IPAddress sender, bool create)
+{
+  SyncBase *lru = nullptr;
+  for (size_t i = 0; i < UDP_SYNC_BASES; i++) {
+    SyncBase &b = syncBases[i];
+    if (b.used && b.ip == sender) { b.lastUse = millis(); return &b; }
+    if (!lru || (lru->used && (!b.used || b.lastUse < lru->lastUse))) lru = &b; // prefer unused entries
+  }
+  if (!create) return nullptr;
+  free(lru->data);
+  lru->data = nullptr;
+  lru->len = lru->seq = 0;
+  lru->ip = sender;
+  lru->lastUse = millis();
+  lru->resyncSent = 0;
+  lru->used = true;
+  return lru;
+}
+
+static void storeSyncKeyframe(const byte *udpIn, uint16_t len, IPAddress sender)
+{
+  SyncBase *b = getSyncBase(sender, true);
+  len -= UDP_DELTA_TRAILER;
+  if (!b->data || b->len != len) {
+    free(b->data);
+    b->data = (byte*)malloc(len);
+    if (!b->data) { b->len = 0; return; }
+  }
+  memcpy(b->data, udpIn, len);
+  b->len = len;
+  b->seq = (udpIn[len] << 8) | udpIn[len+1];
+}
+
+// patches base of sender with delta, returns nullptr if the delta does not follow the base
+static const byte* applySyncDelta(const byte *udpIn, uint16_t len, IPAddress sender, uint32_t &segMask)
+{
+  uint16_t seq     = (udpIn[3] << 8) | udpIn[4];
+  uint16_t fullLen = (udpIn[6] << 8) | udpIn[7];
+  SyncBase *b = getSyncBase(sender, false);
+  if (!b || !b->data || !b->len || fullLen != b->len || seq != (uint16_t)(b->seq + 1)) return nullptr;
+  byte *syncBase = b->data;
+
+  // validate all runs before touching the base
+  for (size_t pos = UDP_DELTA_HEADER; pos < len; ) {
+    if (pos + UDP_DELTA_RUN_HEADER > len) return false;
+    uint16_t ofs = (udpIn[pos] << 8) | udpIn[pos+1];
+    uint8_t runLen = udpIn[pos+2];
+    pos += UDP_DELTA_RUN_HEADER + runLen;
+    if (pos > len || ofs + runLen > b->len) return nullptr;
+  }
+  uint8_t segSize = syncBase[40] ? syncBase[40] : UDP_SEG_SIZE;
+  segMask = 0;
+  for (size_t pos = UDP_DELTA_HEADER; pos < len; ) {
+    uint16_t ofs = (udpIn[pos] << 8) | udpIn[pos+1];
+    uint8_t runLen = udpIn[pos+2];
+    pos += UDP_DELTA_RUN_HEADER;
+    memcpy(syncBase + ofs, udpIn + pos, runLen);
+    pos += runLen;
+    if (ofs + runLen > 41 && runLen) {
+      for (size_t s = (max((int)ofs, 41) - 41) / segSize; s <= (size_t)(ofs + runLen - 1 - 41) / segSize && s < 32; s++) segMask |= 1UL << s;
+    }
+  }
+  if (syncBase[40] != segSize) segMask = UINT32_MAX; // segment record size changed
+  b->seq = seq;
+  return syncBase;
+}
+
+static void requestSyncResync(IPAddress sender, uint8_t groups)
+{
+  SyncBase *b = getSyncBase(sender, true); // remembers when the request was sent, even without a base
+  if (b->resyncSent && millis() - b->resyncSent < UDP_RESYNC_INTERVAL) return;
+  DEBUG_PRINTLN(F("Sync delta gap, requesting keyframe."));
+  byte req[UDP_DELTA_HEADER] = {UDP_DELTA_PACKET, UDP_DELTA_VERSION, groups, 0, 0, UDP_DELTA_RESYNC, 0, 0};
+  notifierUdp.beginPacket(sender, udpPort);
+  notifierUdp.write(req, UDP_DELTA_HEADER);
+  notifierUdp.endPacket();
+  b->resyncSent = millis();
+}
 
+// reads and processes one packet from notifier or realtime sockets, returns false if none was pending
+static bool receiveUDPPacket()
+{
+  IPAddress localIP;
   bool isSupp = false;
   size_t packetSize = notifierUdp.parsePacket();
   if (!packetSize && udp2Connected) {
@@ -242,32 +618,27 @@ void handleNotifications()
   if (!packetSize && udpRgbConnected) {
     packetSize = rgbUdp.parsePacket();
     if (packetSize) {
-      if (!receiveDirect) return;
-      if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) return;
+      if (!receiveDirect) return true;
+      if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) return true;
       realtimeIP = rgbUdp.remoteIP();
       DEBUG_PRINTLN(rgbUdp.remoteIP());
       uint8_t lbuf[packetSize];
       rgbUdp.read(lbuf, packetSize);
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
-      if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
-      uint16_t id = 0;
-      uint16_t totalLen = strip.getLengthTotal();
-      for (size_t i = 0; i < packetSize -2; i += 3)
-      {
-        setRealtimePixel(id, lbuf[i], lbuf[i+1], lbuf[i+2], 0);
-        id++; if (id >= totalLen) break;
-      }
+      if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return true;
+      setRealtimePixels(0, packetSize / 3, lbuf);
       if (!(realtimeMode && useMainSegmentOnly)) strip.show();
-      return;
+      return true;
     }
   }
 
-  if (!(receiveNotifications || receiveDirect)) return;
+  if (!(receiveNotifications || receiveDirect)) return packetSize > 0;
 
   localIP = Network.localIP();
   //notifier and UDP realtime
-  if (!packetSize || packetSize > UDP_IN_MAXSIZE) return;
-  if (!isSupp && notifierUdp.remoteIP() == localIP) return; //don't process broadcasts we send ourselves
+  if (!packetSize) return false;
+  if (packetSize > UDP_IN_MAXSIZE) return true; // skipped, discarded by next parsePacket()
+  if (!isSupp && notifierUdp.remoteIP() == localIP) return true; //don't process broadcasts we send ourselves
 
   uint8_t udpIn[packetSize +1];
   uint16_t len;
@@ -276,194 +647,98 @@ void handleNotifications()
 
   // WLED nodes info notifications
   if (isSupp && udpIn[0] == 255 && udpIn[1] == 1 && len >= 40) {
-    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return;
-
-    uint8_t unit = udpIn[39];
-    NodesMap::iterator it = Nodes.find(unit);
-    if (it == Nodes.end() && Nodes.size() < WLED_MAX_NODES) { // Create a new element when not present
-      Nodes[unit].age = 0;
-      it = Nodes.find(unit);
-    }
-
-    if (it != Nodes.end()) {
-      for (size_t x = 0; x < 4; x++) {
-        it->second.ip[x] = udpIn[x + 2];
-      }
-      it->second.age = 0; // reset 'age counter'
-      char tmpNodeName[33] = { 0 };
-      memcpy(&tmpNodeName[0], reinterpret_cast<byte *>(&udpIn[6]), 32);
-      tmpNodeName[32]     = 0;
-      it->second.nodeName = tmpNodeName;
-      it->second.nodeName.trim();
-      it->second.nodeType = udpIn[38];
+    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return true;
+
+    NodeStruct *node = Nodes.update(IPAddress(udpIn[2], udpIn[3], udpIn[4], udpIn[5]));
+    if (node) {
+      node->age = 0; // reset 'age counter'
+      memcpy(node->nodeName, &udpIn[6], NODE_NAME_LEN);
+      node->nodeName[NODE_NAME_LEN] = 0;
+      for (int x = strlen(node->nodeName) - 1; x >= 0 && isspace(node->nodeName[x]); x--) node->nodeName[x] = 0; // trim
+      node->nodeType = udpIn[38];
       uint32_t build = 0;
       if (len >= 44)
         for (size_t i=0; i<sizeof(uint32_t); i++)
           build |= udpIn[40+i]<<(8*i);
-      it->second.build = build;
+      node->build = build;
     }
-    return;
+    return true;
   }
 
   //wled notifier, ignore if realtime packets active
   if (udpIn[0] == 0 && !realtimeMode && receiveNotifications)
   {
-    //ignore notification if received within a second after sending a notification ourselves
-    if (millis() - notificationSentTime < 1000) return;
-    if (udpIn[1] > 199) return; //do not receive custom versions
-
-    //compatibilityVersionByte:
-    byte version = udpIn[11];
-
-    // if we are not part of any sync group ignore message
-    if (version < 9 || version > 199) {
-      // legacy senders are treated as if sending in sync group 1 only
-      if (!(receiveGroups & 0x01)) return;
-    } else if (!(receiveGroups & udpIn[36])) return;
-
-    bool someSel = (receiveNotificationBrightness || receiveNotificationColor || receiveNotificationEffects);
-
-    //apply colors from notification to main segment, only if not syncing full segments
-    if ((receiveNotificationColor || !someSel) && (version < 11 || !receiveSegmentOptions)) {
-      // primary color, only apply white if intented (version > 0)
-      strip.setColor(0, RGBW32(udpIn[3], udpIn[4], udpIn[5], (version > 0) ? udpIn[10] : 0));
-      if (version > 1) {
-        strip.setColor(1, RGBW32(udpIn[12], udpIn[13], udpIn[14], udpIn[15])); // secondary color
-      }
-      if (version > 6) {
-        strip.setColor(2, RGBW32(udpIn[20], udpIn[21], udpIn[22], udpIn[23])); // tertiary color
-        if (version > 9 && version < 200 && udpIn[37] < 255) { // valid CCT/Kelvin value
-          uint16_t cct = udpIn[38];
-          if (udpIn[37] > 0) { //Kelvin
-            cct |= (udpIn[37] << 8);
-          }
-          strip.setCCT(cct);
-        }
-      }
+    IPAddress sender = isSupp ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
+    if (isSyncKeyframe(udpIn, len)) storeSyncKeyframe(udpIn, len, sender);
+    else {
+      SyncBase *b = getSyncBase(sender, false);
+      if (b) b->len = 0; // sender no longer sends deltas
     }
 
-    bool timebaseUpdated = false;
-    //apply effects from notification
-    bool applyEffects = (receiveNotificationEffects || !someSel);
-    if (version < 200)
-    {
-      if (applyEffects && currentPlaylist >= 0) unloadPlaylist();
-      if (version > 10 && (receiveSegmentOptions || receiveSegmentBounds)) {
-        uint8_t numSrcSegs = udpIn[39];
-        for (size_t i = 0; i < numSrcSegs; i++) {
-          uint16_t ofs = 41 + i*udpIn[40]; //start of segment offset byte
-          uint8_t id = udpIn[0 +ofs];
-          if (id > strip.getSegmentsNum()) break;
-
-          Segment& selseg = strip.getSegment(id);
-          if (!selseg.isActive() || !selseg.isSelected()) continue; //do not apply to non selected segments
-
-          uint16_t startY = 0, start  = (udpIn[1+ofs] << 8 | udpIn[2+ofs]);
-          uint16_t stopY  = 1, stop   = (udpIn[3+ofs] << 8 | udpIn[4+ofs]);
-          uint16_t offset = (udpIn[7+ofs] << 8 | udpIn[8+ofs]);
-          if (!receiveSegmentOptions) {
-            selseg.setUp(start, stop, selseg.grouping, selseg.spacing, offset, startY, stopY);
-            continue;
-          }
-          //for (size_t j = 1; j<4; j++) selseg.setOption(j, (udpIn[9 +ofs] >> j) & 0x01); //only take into account mirrored, on, reversed; ignore selected
-          selseg.options = (selseg.options & 0x0071U) | (udpIn[9 +ofs] & 0x0E); // ignore selected, freeze, reset & transitional
-          selseg.setOpacity(udpIn[10+ofs]);
-          if (applyEffects) {
-            strip.setMode(id,  udpIn[11+ofs]);
-            selseg.speed     = udpIn[12+ofs];
-            selseg.intensity = udpIn[13+ofs];
-            selseg.palette   = udpIn[14+ofs];
-          }
-          if (receiveNotificationColor || !someSel) {
-            selseg.setColor(0, RGBW32(udpIn[15+ofs],udpIn[16+ofs],udpIn[17+ofs],udpIn[18+ofs]));
-            selseg.setColor(1, RGBW32(udpIn[19+ofs],udpIn[20+ofs],udpIn[21+ofs],udpIn[22+ofs]));
-            selseg.setColor(2, RGBW32(udpIn[23+ofs],udpIn[24+ofs],udpIn[25+ofs],udpIn[26+ofs]));
-            selseg.setCCT(udpIn[27+ofs]);
-          }
-          if (version > 11) {
-            // when applying synced options ignore selected as it may be used as indicator of which segments to sync
-            // freeze, reset & transitional should never be synced
-            selseg.options = (selseg.options & 0x0071U) | (udpIn[28+ofs]<<8) | (udpIn[9 +ofs] & 0x8E); // ignore selected, freeze, reset & transitional
-            if (applyEffects) {
-              selseg.custom1 = udpIn[29+ofs];
-              selseg.custom2 = udpIn[30+ofs];
-              selseg.custom3 = udpIn[31+ofs] & 0x1F;
-              selseg.check1  = (udpIn[31+ofs]>>5) & 0x1;
-              selseg.check1  = (udpIn[31+ofs]>>6) & 0x1;
-              selseg.check1  = (udpIn[31+ofs]>>7) & 0x1;
-            }
-            startY = (udpIn[32+ofs] << 8 | udpIn[33+ofs]);
-            stopY  = (udpIn[34+ofs] << 8 | udpIn[35+ofs]);
-          }
-          if (receiveSegmentBounds) {
-            selseg.setUp(start, stop, udpIn[5+ofs], udpIn[6+ofs], offset, startY, stopY);
-          } else {
-            selseg.setUp(selseg.start, selseg.stop, udpIn[5+ofs], udpIn[6+ofs], selseg.offset, selseg.startY, selseg.stopY);
-          }
-        }
-        stateChanged = true;
-      }
+    //ignore notification if received within a second after sending a notification ourselves
+    if (millis() - notificationSentTime < 1000) return true;
+    if (udpIn[1] > 199) return true; //do not receive custom versions
 
-      // simple effect sync, applies to all selected segments
-      if (applyEffects && (version < 11 || !receiveSegmentOptions)) {
-        for (size_t i = 0; i < strip.getSegmentsNum(); i++) {
-          Segment& seg = strip.getSegment(i);
-          if (!seg.isActive() || !seg.isSelected()) continue;
-          seg.setMode(udpIn[8]);
-          seg.speed = udpIn[9];
-          if (version > 2) seg.intensity = udpIn[16];
-          if (version > 4) seg.setPalette(udpIn[19]);
-        }
-        stateChanged = true;
-      }
+    applyNotification(udpIn, UINT32_MAX);
+    return true;
+  }
 
-      if (applyEffects && version > 5) {
-        uint32_t t = (udpIn[25] << 24) | (udpIn[26] << 16) | (udpIn[27] << 8) | (udpIn[28]);
-        t += PRESUMED_NETWORK_DELAY; //adjust trivially for network delay
-        t -= millis();
-        strip.timebase = t;
-        timebaseUpdated = true;
-      }
+  //wled delta sync, base is kept up to date even if it can not be applied right now
+  if (udpIn[0] == UDP_DELTA_PACKET && receiveNotifications)
+  {
+    if (len < UDP_DELTA_HEADER || udpIn[1] != UDP_DELTA_VERSION) return true;
+    IPAddress sender = isSupp ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
+    if (udpIn[5] == UDP_DELTA_RESYNC) {
+      if (syncLastSent && (syncGroups & udpIn[2])) syncResyncRequested = true;
+      return true;
     }
-
-    //adjust system time, but only if sender is more accurate than self
-    if (version > 7 && version < 200)
-    {
-      Toki::Time tm;
-      tm.sec = (udpIn[30] << 24) | (udpIn[31] << 16) | (udpIn[32] << 8) | (udpIn[33]);
-      tm.ms = (udpIn[34] << 8) | (udpIn[35]);
-      if (udpIn[29] > toki.getTimeSource()) { //if sender's time source is more accurate
-        toki.adjust(tm, PRESUMED_NETWORK_DELAY); //adjust trivially for network delay
-        uint8_t ts = TOKI_TS_UDP;
-        if (udpIn[29] > 99) ts = TOKI_TS_UDP_NTP;
-        else if (udpIn[29] >= TOKI_TS_SEC) ts = TOKI_TS_UDP_SEC;
-        toki.setTime(tm, ts);
-      } else if (timebaseUpdated && toki.getTimeSource() > 99) { //if we both have good times, get a more accurate timebase
-        Toki::Time myTime = toki.getTime();
-        uint32_t diff = toki.msDifference(tm, myTime);
-        strip.timebase -= PRESUMED_NETWORK_DELAY; //no need to presume, use difference between NTP times at send and receive points
-        if (toki.isLater(tm, myTime)) {
-          strip.timebase += diff;
-        } else {
-          strip.timebase -= diff;
-        }
-      }
+    if (!(receiveGroups & udpIn[2])) return true;
+    uint32_t segMask = 0;
+    const byte *syncBase = applySyncDelta(udpIn, len, sender, segMask);
+    if (!syncBase) { // missed a packet, state of sender unknown
+      requestSyncResync(sender, udpIn[2]);
+      return true;
     }
+    if (realtimeMode || millis() - notificationSentTime < 1000) return true;
+    if (syncBase[1] > 199) return true; //do not receive custom versions
+    applyNotification(syncBase, segMask);
+    return true;
+  }
 
-    if (version > 3)
-    {
-      transitionDelayTemp = ((udpIn[17] << 0) & 0xFF) + ((udpIn[18] << 8) & 0xFF00);
+  //effect clock sync
+  if (udpIn[0] == UDP_CLOCK_PACKET && len >= UDP_CLOCK_SIZE)
+  {
+    uint32_t rxUs = effectTimeUs();
+    IPAddress sender = isSupp ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
+    if (udpIn[1] == UDP_CLOCK_REQUEST && clockSyncMode == CLOCK_SYNC_MASTER && (syncGroups & udpIn[2])) {
+      udpIn[1] = UDP_CLOCK_REPLY;
+      udpIn[2] = syncGroups;
+      writeClockTime(udpIn +  7, rxUs);
+      writeClockTime(udpIn + 15, strip.timebase + millis());
+      writeClockTime(udpIn + 11, effectTimeUs());
+      WiFiUDP &udp = isSupp ? notifier2Udp : notifierUdp;
+      udp.beginPacket(sender, udp.remotePort());
+      udp.write(udpIn, UDP_CLOCK_SIZE);
+      udp.endPacket();
+    } else if (udpIn[1] == UDP_CLOCK_REPLY && clockSyncMode == CLOCK_SYNC_FOLLOWER && (receiveGroups & udpIn[2])) {
+      uint32_t t1 = readClockTime(udpIn + 3);
+      if (!clockRequestUs || t1 != clockRequestUs) return true; // stale or already answered by another master
+      clockRequestUs = 0;
+      clockMasterIP = sender;
+      clockReplyTime = millis();
+      // timestamps only compare within 35 minutes, step coarsely first if timebases are far apart
+      int32_t coarse = (int32_t)(readClockTime(udpIn + 15) + (rxUs - t1) / 2000 - (strip.timebase + millis()));
+      if (coarse > 1000 || coarse < -1000) {
+        strip.timebase += coarse;
+        clockSync.reset();
+      } else {
+        clockSync.addSample(t1, readClockTime(udpIn + 7), readClockTime(udpIn + 11), rxUs);
+      }
     }
-
-    nightlightActive = udpIn[6];
-    if (nightlightActive) nightlightDelayMins = udpIn[7];
-
-    if (receiveNotificationBrightness || !someSel) bri = udpIn[2];
-    stateUpdated(CALL_MODE_NOTIFICATION);
-    return;
+    return true;
   }
 
-  if (!receiveDirect) return;
+  if (!receiveDirect) return true;
 
   //TPM2.NET
   if (udpIn[0] == 0x9c)
@@ -472,13 +747,13 @@ void handleNotifications()
     //if the number of LEDs in your installation doesn't allow that, please include padding bytes at the end of the last packet
     byte tpmType = udpIn[1];
     if (tpmType == 0xaa) { //TPM2.NET polling, expect answer
-      sendTPM2Ack(); return;
+      sendTPM2Ack(); return true;
     }
-    if (tpmType != 0xda) return; //return if notTPM2.NET data
+    if (tpmType != 0xda) return true; //return if notTPM2.NET data
 
     realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
     realtimeLock(realtimeTimeoutMs, REALTIME_MODE_TPM2NET);
-    if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
+    if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return true;
 
     tpmPacketCount++; //increment the packet count
     if (tpmPacketCount == 1) tpmPayloadFrameSize = (udpIn[2] << 8) + udpIn[3]; //save frame size for the whole payload if this is the first packet
@@ -486,22 +761,14 @@ void handleNotifications()
     byte numPackets = udpIn[5];
 
     uint16_t id = (tpmPayloadFrameSize/3)*(packetNum-1); //start LED
-    uint16_t totalLen = strip.getLengthTotal();
-    for (size_t i = 6; i < tpmPayloadFrameSize + 4U; i += 3)
-    {
-      if (id < totalLen)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        id++;
-      }
-      else break;
-    }
+    size_t   count = packetSize > 6 ? min((size_t)tpmPayloadFrameSize, packetSize - 6) / 3 : 0;
+    setRealtimePixels(id, count, &udpIn[6]);
     if (tpmPacketCount == numPackets) //reset packet count and show if all packets were received
     {
       tpmPacketCount = 0;
       strip.show();
     }
-    return;
+    return true;
   }
 
   //UDP realtime: 1 warls 2 drgb 3 drgbw
@@ -509,18 +776,17 @@ void handleNotifications()
   {
     realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
     DEBUG_PRINTLN(realtimeIP);
-    if (packetSize < 2) return;
+    if (packetSize < 2) return true;
 
     if (udpIn[1] == 0)
     {
       realtimeTimeout = 0;
-      return;
+      return true;
     } else {
       realtimeLock(udpIn[1]*1000 +1, REALTIME_MODE_UDP);
     }
-    if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
+    if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return true;
 
-    uint16_t totalLen = strip.getLengthTotal();
     if (udpIn[0] == 1) //warls
     {
       for (size_t i = 2; i < packetSize -3; i += 4)
@@ -529,43 +795,21 @@ void handleNotifications()
       }
     } else if (udpIn[0] == 2) //drgb
     {
-      uint16_t id = 0;
-      for (size_t i = 2; i < packetSize -2; i += 3)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-
-        id++; if (id >= totalLen) break;
-      }
+      setRealtimePixels(0, (packetSize - 2) / 3, &udpIn[2], REALTIME_PIXELS_RGB);
     } else if (udpIn[0] == 3) //drgbw
     {
-      uint16_t id = 0;
-      for (size_t i = 2; i < packetSize -3; i += 4)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-
-        id++; if (id >= totalLen) break;
-      }
+      setRealtimePixels(0, (packetSize - 2) / 4, &udpIn[2], REALTIME_PIXELS_RGBW);
     } else if (udpIn[0] == 4) //dnrgb
     {
       uint16_t id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (size_t i = 4; i < packetSize -2; i += 3)
-      {
-        if (id >= totalLen) break;
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        id++;
-      }
+      if (packetSize > 4) setRealtimePixels(id, (packetSize - 4) / 3, &udpIn[4], REALTIME_PIXELS_RGB);
     } else if (udpIn[0] == 5) //dnrgbw
     {
       uint16_t id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (size_t i = 4; i < packetSize -2; i += 4)
-      {
-        if (id >= totalLen) break;
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-        id++;
-      }
+      if (packetSize > 4) setRealtimePixels(id, (packetSize - 4) / 4, &udpIn[4], REALTIME_PIXELS_RGBW);
     }
     strip.show();
-    return;
+    return true;
   }
 
   // API over UDP
@@ -583,6 +827,78 @@ void handleNotifications()
     }
     releaseJSONBufferLock();
   }
+  return true;
+}
+
+
+// follower: slew timebase and request the next sample
+static void handleClockSync()
+{
+  if (clockSyncMode != CLOCK_SYNC_FOLLOWER) return;
+  unsigned long now = millis();
+  int32_t correction = clockSync.takeCorrection(now);
+  if (correction) strip.timebase += correction;
+
+  if (now - clockReplyTime > CLOCK_SYNC_TIMEOUT && uint32_t(clockMasterIP) != 0) {
+    DEBUG_PRINTLN(F("Clock master lost."));
+    clockMasterIP = IPAddress(0,0,0,0);
+    clockSync.reset();
+  }
+  if (now - clockRequestTime < (clockSync.isLocked() ? CLOCK_SYNC_INTERVAL : CLOCK_SYNC_FAST_INTERVAL)) return;
+
+  byte req[UDP_CLOCK_SIZE] = {UDP_CLOCK_PACKET, UDP_CLOCK_REQUEST, receiveGroups};
+  clockRequestTime = now;
+  clockRequestUs = effectTimeUs() | 1; // never 0
+  writeClockTime(req + 3, clockRequestUs);
+  IPAddress dest = clockMasterIP;
+  if (uint32_t(dest) == 0) dest = ~uint32_t(Network.subnetMask()) | uint32_t(Network.gatewayIP());
+  notifierUdp.beginPacket(dest, udpPort);
+  notifierUdp.write(req, UDP_CLOCK_SIZE);
+  notifierUdp.endPacket();
+}
+
+void handleNotifications()
+{
+  //send second notification if enabled
+  if(udpConnected && (notificationCount < udpNumRetries) && ((millis()-notificationSentTime) > 250)){
+    notify(notificationSentCallMode,true);
+  }
+
+  //send keyframe if deltas were sent or a receiver missed one
+  if (udpConnected && syncDelta && syncLastSent) {
+    unsigned long now = millis();
+    if ((syncResyncRequested && now - syncKeyframeTime > UDP_RESYNC_INTERVAL) ||
+        (syncKeyframeDue && now - notificationSentTime > UDP_KEYFRAME_TRAILING)) {
+      byte udpOut[WLEDPACKETSIZE + UDP_DELTA_TRAILER];
+      buildNotifierPacket(udpOut, notificationSentCallMode, false);
+      sendSyncKeyframe(udpOut);
+    }
+  }
+
+  handleE131Ingest();
+  handleRealtimeFrame();
+  if (e131NewData && millis() - strip.getLastShow() > 15)
+  {
+    e131NewData = false;
+    strip.show();
+  }
+
+  //unlock strip when realtime UDP times out
+  if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
+
+  //receive UDP notifications
+  if (!udpConnected) return;
+  handleClockSync();
+
+  // drain pending packets of all sockets, bounded by count and time so the strip keeps being serviced
+  unsigned long ingestStart = micros();
+  for (uint8_t n = 0; n < UDP_INGEST_MAX_PACKETS; n++) {
+    if (!receiveUDPPacket()) return; // all caught up
+    if (micros() - ingestStart > UDP_INGEST_BUDGET_US) {
+      udpIngestDeferred++; // budget exhausted, remaining packets wait for next loop iteration
+      break;
+    }
+  }
 }
 
 
@@ -605,26 +921,56 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   }
 }
 
+static inline uint32_t realtimeColor(const uint8_t *p, bool rgbw, bool gamma)
+{
+  uint8_t w = rgbw ? p[3] : 0;
+  if (gamma) return RGBW32(gamma8(p[0]), gamma8(p[1]), gamma8(p[2]), gamma8(w));
+  return RGBW32(p[0], p[1], p[2], w);
+}
+
+// bulk variant of setRealtimePixel(): len consecutive pixels, data has 3 (RGB) or 4 (RGBW) bytes per pixel
+// gamma, offset and target are resolved once per run and each bus is looked up once instead of per pixel
+void setRealtimePixels(uint16_t start, uint16_t len, const uint8_t *data, uint8_t format)
+{
+  const bool rgbw  = format == REALTIME_PIXELS_RGBW;
+  const bool gamma = !arlsDisableGammaCorrection && gammaCorrectCol;
+  int first = start + arlsOffset;
+  int last  = first + len; // exclusive
+  if (first < 0) { data += (-first) * format; first = 0; }
+
+  if (useMainSegmentOnly) {
+    Segment &seg = strip.getMainSegment();
+    last = min(last, (int)seg.length());
+    for (int pix = first; pix < last; pix++, data += format) seg.setPixelColor(pix, realtimeColor(data, rgbw, gamma));
+    return;
+  }
+
+  last = min(last, (int)strip.getLengthTotal());
+  if (first >= last) return;
+
+  if (strip.hasLedMap()) {
+    // logical to physical mapping has to be applied per pixel
+    for (int pix = first; pix < last; pix++, data += format) strip.setPixelColor(pix, realtimeColor(data, rgbw, gamma));
+    return;
+  }
+
+  // copy directly into each bus that overlaps the run
+  for (uint8_t b = 0; b < busses.getNumBusses(); b++) {
+    Bus *bus = busses.getBus(b);
+    int bstart = bus->getStart();
+    int lo = max(first, bstart);
+    int hi = min(last, bstart + (int)bus->getLength());
+    const uint8_t *src = data + (lo - first) * format;
+    for (int pix = lo; pix < hi; pix++, src += format) bus->setPixelColor(pix - bstart, realtimeColor(src, rgbw, gamma));
+  }
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
 void refreshNodeList()
 {
-  for (NodesMap::iterator it = Nodes.begin(); it != Nodes.end();) {
-    bool mustRemove = true;
-
-    if (it->second.ip[0] != 0) {
-      if (it->second.age < 10) {
-        it->second.age++;
-        mustRemove = false;
-        ++it;
-      }
-    }
-
-    if (mustRemove) {
-      it = Nodes.erase(it);
-    }
-  }
+  Nodes.refresh();
 }
 
 /*********************************************************************************************\
@@ -718,6 +1064,154 @@ static       size_t sequenceNumber = 0; // this needs to be shared across all ou
 static const size_t ART_NET_HEADER_SIZE = 12;
 static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
 
+#define E131_HEADER_SIZE   E131_DMP_DATA // up to the DMX start code (at E131_DMP_DATA, not included)
+#define E131_SYNC_SIZE     49
+#define E131_VECTOR_ROOT_DATA          0x00000004
+#define E131_VECTOR_ROOT_EXTENDED      0x00000008
+#define E131_VECTOR_DATA_PACKET        0x00000002
+#define E131_VECTOR_EXTENDED_SYNC      0x00000001
+#define E131_DMP_VECTOR_SET_PROPERTY   0x02
+#define E131_DMP_ADDRESS_TYPE          0xa1
+
+static uint8_t e131SequenceNumber = 0;
+static const byte ACN_PACKET_ID[] PROGMEM = {0x41,0x53,0x43,0x2d,0x45,0x31,0x2e,0x31,0x37,0x00,0x00,0x00}; // "ASC-E1.17"
+
+static uint8_t e131Cid[16];   // component identifier (UUID), see getE131Cid()
+static bool    e131CidValid = false;
+
+static inline void writeBE16(uint8_t *p, uint16_t v) { p[0] = v >> 8; p[1] = v; }
+static inline void writeBE32(uint8_t *p, uint32_t v) { p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v; }
+
+// CID: custom UUID (RFC 9562 version 8) derived once from the MAC address with FNV-1a, so it is unique per
+// device and stays the same across reboots; the node part holds the MAC itself
+static const uint8_t* getE131Cid() {
+  if (e131CidValid) return e131Cid;
+  uint8_t mac[6];
+  WiFi.macAddress(mac);
+  uint32_t h = 2166136261UL; // FNV-1a over "WLED-E131" and MAC
+  const char *ns = PSTR("WLED-E131");
+  for (size_t i = 0; i < 9; i++) h = (h ^ pgm_read_byte(ns + i)) * 16777619UL;
+  for (size_t i = 0; i < 10; i++) {
+    h = (h ^ mac[i % 6]) * 16777619UL;
+    e131Cid[i] = h >> 24;
+  }
+  memcpy(e131Cid + 10, mac, 6);
+  e131Cid[6] = (e131Cid[6] & 0x0F) | 0x80; // version 8 (custom)
+  e131Cid[8] = (e131Cid[8] & 0x3F) | 0x80; // RFC 4122 variant
+  e131CidValid = true;
+  return e131Cid;
+}
+
+// fills E1.31 root layer (common to data and sync packets) of a packet with total length len
+static void prepareE131RootLayer(uint8_t *p, uint16_t len, uint32_t vector) {
+  writeBE16(p + E131_ROOT_PREAMBLE_SIZE, 0x0010);
+  writeBE16(p + E131_ROOT_POSTAMBLE_SIZE, 0x0000);
+  memcpy_P(p + E131_ROOT_ID, ACN_PACKET_ID, sizeof(ACN_PACKET_ID));
+  writeBE16(p + E131_ROOT_FLENGTH, 0x7000 | (len - E131_ROOT_FLENGTH));
+  writeBE32(p + E131_ROOT_VECTOR, vector);
+  memcpy(p + E131_ROOT_CID, getE131Cid(), 16);
+}
+
+// sends E1.31 synchronization packet for sync universe (to multicast address of that universe if client is multicast)
+static bool sendE131Sync(WiFiUDP &udp, IPAddress client, uint16_t syncUniverse) {
+  uint8_t p[E131_SYNC_SIZE];
+  prepareE131RootLayer(p, E131_SYNC_SIZE, E131_VECTOR_ROOT_EXTENDED);
+  writeBE16(p + E131_FRAME_FLENGTH, 0x7000 | (E131_SYNC_SIZE - E131_FRAME_FLENGTH));
+  writeBE32(p + E131_FRAME_VECTOR, E131_VECTOR_EXTENDED_SYNC);
+  p[44] = e131SequenceNumber;       // sequence number
+  writeBE16(p + 45, syncUniverse);  // synchronization address
+  writeBE16(p + 47, 0);             // reserved
+  if (client[0] == 239) client = IPAddress(239, 255, (syncUniverse >> 8) & 0xFF, syncUniverse & 0xFF);
+  if (!udp.beginPacket(client, E131_DEFAULT_PORT)) return false;
+  udp.write(p, E131_SYNC_SIZE);
+  return udp.endPacket();
+}
+
+// number of Art-Net packets of a frame of length pixels (universes and ArtSync)
+static size_t getArtnetPacketCount(uint16_t length, bool isRGBW) {
+  const size_t pixelChannels = isRGBW?4:3;
+  size_t channelsPerPacket = constrain(artnetOutChannels, pixelChannels, 512);
+  channelsPerPacket -= channelsPerPacket % pixelChannels;
+  return ((length * pixelChannels - 1) / channelsPerPacket) + 1 + (artnetOutSync ? 1 : 0);
+}
+
+// sends up to count Art-Net packets of a frame starting with packet next (advanced), so paced output
+// can be spread over several calls; returns 1 on error
+static uint8_t sendArtnet(WiFiUDP &udp, IPAddress client, uint16_t length, uint8_t *buffer, uint8_t bri, bool isRGBW, size_t &next, size_t count) {
+  // calculate the number of UDP packets we need to send
+  const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
+  // channels per universe, rounded down so that no pixel is split across universes
+  const size_t pixelChannels = isRGBW?4:3;
+  size_t ARTNET_CHANNELS_PER_PACKET = constrain(artnetOutChannels, pixelChannels, 512);
+  ARTNET_CHANNELS_PER_PACKET -= ARTNET_CHANNELS_PER_PACKET % pixelChannels;
+  const size_t packetCount = ((channelCount-1)/ARTNET_CHANNELS_PER_PACKET)+1;
+  // 15 bit port address: net (7 bit), subnet (4 bit), universe (4 bit); consecutive universes carry into subnet and net
+  const uint16_t portAddress = ((artnetOutNet & 0x7F) << 8) | ((artnetOutSubnet & 0x0F) << 4) | (artnetOutUniverse & 0x0F);
+
+  // whole packet is assembled in a preallocated buffer and written at once
+  static uint8_t packet[ART_NET_HEADER_SIZE + 6 + 512];
+  memcpy_P(packet, ART_NET_HEADER, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
+
+  if (next == 0) {
+    sequenceNumber++;
+    if (sequenceNumber > 255 || sequenceNumber == 0) sequenceNumber = 1; // 0 disables sequencing on receivers
+  }
+
+  for (; next < packetCount && count; next++, count--) {
+    const size_t currentPacket = next;
+    size_t bufferOffset = currentPacket * ARTNET_CHANNELS_PER_PACKET;
+    size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
+
+    if (currentPacket == (packetCount - 1U)) {
+      // last packet
+      if (channelCount % ARTNET_CHANNELS_PER_PACKET) {
+        packetSize = channelCount % ARTNET_CHANNELS_PER_PACKET;
+      }
+    }
+
+    const uint16_t universe = (portAddress + currentPacket) & 0x7FFF;
+    const size_t   dataLength = packetSize + (packetSize & 1); // Art-Net requires an even data length
+
+    packet[ART_NET_HEADER_SIZE  ] = sequenceNumber; // sequence number. 1..255
+    packet[ART_NET_HEADER_SIZE+1] = 0x00; // physical - more an FYI, not really used for anything. 0..3
+    packet[ART_NET_HEADER_SIZE+2] = universe & 0xFF; // SubUni: subnet & universe
+    packet[ART_NET_HEADER_SIZE+3] = universe >> 8;   // Net
+    packet[ART_NET_HEADER_SIZE+4] = 0xFF & (dataLength >> 8); // 16-bit length of channel data, MSB
+    packet[ART_NET_HEADER_SIZE+5] = 0xFF & (dataLength     ); // 16-bit length of channel data, LSB
+
+    uint8_t *dmx = packet + ART_NET_HEADER_SIZE + 6;
+    for (size_t i = 0; i < packetSize; i++) dmx[i] = scale8(buffer[bufferOffset++], bri);
+    if (dataLength > packetSize) dmx[packetSize] = 0;
+
+    if (!udp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
+      DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
+      return 1; // borked
+    }
+    udp.write(packet, ART_NET_HEADER_SIZE + 6 + dataLength);
+    if (!udp.endPacket()) {
+      DEBUG_PRINTLN(F("Art-Net WiFiUDP.endPacket returned an error"));
+      return 1; // borked
+    }
+  }
+
+  // ArtSync: receivers output all universes received since the last sync at once
+  if (artnetOutSync && next == packetCount && count) {
+    next++;
+    byte sync[ART_NET_HEADER_SIZE + 2];
+    memcpy_P(sync, ART_NET_HEADER, ART_NET_HEADER_SIZE);
+    sync[9] = 0x52;                   // OpCode OpSync (0x5200, little endian)
+    sync[ART_NET_HEADER_SIZE  ] = 0;  // Aux1
+    sync[ART_NET_HEADER_SIZE+1] = 0;  // Aux2
+    if (!udp.beginPacket(client, ARTNET_DEFAULT_PORT)) return 1;
+    udp.write(sync, sizeof(sync));
+    if (!udp.endPacket()) {
+      DEBUG_PRINTLN(F("ArtSync WiFiUDP.endPacket returned an error"));
+      return 1; // borked
+    }
+  }
+  return 0;
+}
+
 uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8_t *buffer, uint8_t bri, bool isRGBW)  {
   if (!(apActive || interfacesInited) || !client[0] || !length) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
 
@@ -789,63 +1283,244 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8
     } break;
 
     case 1: //E1.31
-    {
-    } break;
-
-    case 2: //ArtNet
     {
       // calculate the number of UDP packets we need to send
       const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
-      const size_t ARTNET_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
-      const size_t packetCount = ((channelCount-1)/ARTNET_CHANNELS_PER_PACKET)+1;
-
-      uint32_t channel = 0; 
+      const size_t E131_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
+      const size_t packetCount = ((channelCount-1)/E131_CHANNELS_PER_PACKET)+1;
+      const bool multicast = client[0] == 239; // 239.255.x.x: each universe is sent to its own multicast group
+
+      // packet is assembled in place; header (except lengths, sequence & universe) is the same for all universes
+      static uint8_t packet[E131_HEADER_SIZE + 1 + 512];
+      prepareE131RootLayer(packet, sizeof(packet), E131_VECTOR_ROOT_DATA);
+      writeBE32(packet + E131_FRAME_VECTOR, E131_VECTOR_DATA_PACKET);
+      memset(packet + E131_FRAME_SOURCE, 0, 64);
+      strlcpy((char*)packet + E131_FRAME_SOURCE, serverDescription, 64);
+      packet[E131_FRAME_PRIORITY] = e131OutPriority;
+      writeBE16(packet + E131_FRAME_RESERVED, e131OutSyncUniverse); // synchronization address (0 = not synchronized)
+      packet[E131_FRAME_OPT] = 0;
+      packet[E131_DMP_VECTOR] = E131_DMP_VECTOR_SET_PROPERTY;
+      packet[E131_DMP_TYPE] = E131_DMP_ADDRESS_TYPE;
+      writeBE16(packet + E131_DMP_ADDR_FIRST, 0);
+      writeBE16(packet + E131_DMP_ADDR_INC, 1);
+      packet[E131_DMP_DATA] = 0; // DMX start code
+
+      e131SequenceNumber++;
       size_t bufferOffset = 0;
 
-      sequenceNumber++;
-
       for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-
-        if (sequenceNumber > 255) sequenceNumber = 0;
-
-        if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
-          return 1; // borked
+        size_t packetSize = E131_CHANNELS_PER_PACKET;
+        if (currentPacket == (packetCount - 1U) && (channelCount % E131_CHANNELS_PER_PACKET)) {
+          packetSize = channelCount % E131_CHANNELS_PER_PACKET; // last packet
         }
+        const uint16_t universe = e131OutUniverse + currentPacket;
+        const size_t   len = E131_HEADER_SIZE + 1 + packetSize;
 
-        size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
+        writeBE16(packet + E131_ROOT_FLENGTH,  0x7000 | (len - E131_ROOT_FLENGTH));
+        writeBE16(packet + E131_FRAME_FLENGTH, 0x7000 | (len - E131_FRAME_FLENGTH));
+        writeBE16(packet + E131_DMP_FLENGTH,   0x7000 | (len - E131_DMP_FLENGTH));
+        packet[E131_FRAME_SEQ] = e131SequenceNumber;
+        writeBE16(packet + E131_FRAME_UNIVERSE, universe);
+        writeBE16(packet + E131_DMP_COUNT, packetSize + 1); // including start code
 
-        if (currentPacket == (packetCount - 1U)) {
-          // last packet
-          if (channelCount % ARTNET_CHANNELS_PER_PACKET) {
-            packetSize = channelCount % ARTNET_CHANNELS_PER_PACKET;
-          }
-        }
+        uint8_t *dmx = packet + E131_DMP_DATA + 1;
+        for (size_t i = 0; i < packetSize; i++) dmx[i] = scale8(buffer[bufferOffset++], bri);
 
-        byte header_buffer[ART_NET_HEADER_SIZE];
-        memcpy_P(header_buffer, ART_NET_HEADER, ART_NET_HEADER_SIZE);
-        ddpUdp.write(header_buffer, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
-        ddpUdp.write(sequenceNumber & 0xFF); // sequence number. 1..255
-        ddpUdp.write(0x00); // physical - more an FYI, not really used for anything. 0..3
-        ddpUdp.write((currentPacket) & 0xFF); // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
-        ddpUdp.write(0x00); // Universe MSB, unused.
-        ddpUdp.write(0xFF & (packetSize >> 8)); // 16-bit length of channel data, MSB
-        ddpUdp.write(0xFF & (packetSize     )); // 16-bit length of channel data, LSB
-
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
+        if (!ddpUdp.beginPacket(multicast ? IPAddress(239, 255, (universe >> 8) & 0xFF, universe & 0xFF) : client, E131_DEFAULT_PORT)) {
+          DEBUG_PRINTLN(F("E1.31 WiFiUDP.beginPacket returned an error"));
+          return 1; // borked
         }
-
+        ddpUdp.write(packet, len);
         if (!ddpUdp.endPacket()) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.endPacket returned an error"));
+          DEBUG_PRINTLN(F("E1.31 WiFiUDP.endPacket returned an error"));
           return 1; // borked
         }
-        channel += packetSize;
+      }
+
+      // tell receivers to present all universes of this frame at once
+      if (e131OutSyncUniverse && !sendE131Sync(ddpUdp, client, e131OutSyncUniverse)) {
+        DEBUG_PRINTLN(F("E1.31 sync failed"));
+        return 1;
       }
     } break;
+
+    case 2: //ArtNet
+    {
+      size_t next = 0;
+      if (sendArtnet(ddpUdp, client, length, buffer, bri, isRGBW, next, SIZE_MAX)) return 1;
+    } break;
   }
   return 0;
 }
+
+
+/*
+ * Asynchronous network bus output
+ * BusNetwork::show() only snapshots its pixel data into a pooled packet buffer and queues it.
+ * On ESP32 queued packets are sent by a dedicated task, on ESP8266 from the main loop (handleNetworkOutput()).
+ * Paced Art-Net frames (artnetOutPacing) are sent one universe at a time: the task sleeps between packets,
+ * the main loop sends the next universe once it is due and continues with other work meanwhile.
+ */
+#ifndef WLED_NETOUT_POOL
+  #ifdef ESP8266
+    #define WLED_NETOUT_POOL 4
+  #else
+    #define WLED_NETOUT_POOL 8
+  #endif
+#endif
+
+typedef struct NetOutPacket {
+  uint8_t  *data;    // snapshot of bus pixel data
+  size_t   size;     // allocated size of data (buffers only grow)
+  uint16_t length;   // number of pixels
+  IPAddress client;
+  uint8_t  type;
+  uint8_t  bri;
+  bool     isRGBW;
+  uint16_t next;     // paced Art-Net: packets of this frame already sent
+  uint32_t lastSend; // paced Art-Net: micros() of last packet sent
+  uint32_t queued;   // micros() when queued
+} NetOutPacket;
+
+static NetOutPacket netOutPool[WLED_NETOUT_POOL];
+static WiFiUDP      netOutUdp; // paced Art-Net, kept so the socket is not recreated for every universe
+
+#ifdef ARDUINO_ARCH_ESP32
+static QueueHandle_t netOutFree  = nullptr; // indices of unused pool entries
+static QueueHandle_t netOutReady = nullptr; // indices of pool entries waiting to be sent
+static TaskHandle_t  netOutTask  = nullptr;
+#else
+static uint8_t netOutHead  = 0; // pool is used as FIFO ring
+static uint8_t netOutCount = 0;
+#endif
+
+// returns false if a paced frame has packets left (the next one is not due yet), force sends all of them
+static bool sendNetOutPacket(NetOutPacket &pkt, bool force = false) {
+  if (pkt.type == 2 && (artnetOutPacing || pkt.next)) {
+    if (!force && pkt.next && micros() - pkt.lastSend < artnetOutPacing) return false;
+    size_t next = pkt.next;
+    bool ok = !sendArtnet(netOutUdp, pkt.client, pkt.length, pkt.data, pkt.bri, pkt.isRGBW, next, force ? SIZE_MAX : 1);
+    pkt.next = next;
+    pkt.lastSend = micros();
+    if (ok && next < getArtnetPacketCount(pkt.length, pkt.isRGBW)) return false;
+    pkt.next = 0;
+  } else {
+    realtimeBroadcast(pkt.type, pkt.client, pkt.length, pkt.data, pkt.bri, pkt.isRGBW);
+  }
+  uint32_t latency = micros() - pkt.queued;
+  netOutLatency = (netOutLatency * 7 + latency) >> 3; // running average
+  if (latency > netOutMaxLatency) netOutMaxLatency = latency;
+  netOutSent++;
+  return true;
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+static void netOutTaskLoop(void *) {
+  uint8_t idx;
+  for (;;) {
+    if (xQueueReceive(netOutReady, &idx, portMAX_DELAY) != pdTRUE) continue;
+    NetOutPacket &pkt = netOutPool[idx];
+    while (!sendNetOutPacket(pkt)) {
+      // wait for next paced packet: sleep whole ticks, only the remainder below a tick is spent here
+      uint32_t elapsed = micros() - pkt.lastSend;
+      if (elapsed >= artnetOutPacing) continue;
+      uint32_t wait = artnetOutPacing - elapsed;
+      if (wait >= portTICK_PERIOD_MS * 1000U) vTaskDelay(wait / (portTICK_PERIOD_MS * 1000U));
+      else delayMicroseconds(wait);
+    }
+    xQueueSend(netOutFree, &idx, 0);
+  }
+}
+
+static bool initNetworkOutput() {
+  if (netOutTask) return true;
+  if (!netOutFree)  netOutFree  = xQueueCreate(WLED_NETOUT_POOL, sizeof(uint8_t));
+  if (!netOutReady) netOutReady = xQueueCreate(WLED_NETOUT_POOL, sizeof(uint8_t));
+  if (!netOutFree || !netOutReady) return false;
+  xQueueReset(netOutFree);
+  xQueueReset(netOutReady);
+  for (uint8_t i = 0; i < WLED_NETOUT_POOL; i++) xQueueSend(netOutFree, &i, 0);
+  // core 0 runs the WiFi stack, the main loop runs on core 1 (on single core chips both are core 0)
+  if (xTaskCreatePinnedToCore(netOutTaskLoop, "netOut", 4096, nullptr, 1, &netOutTask, 0) != pdPASS) {
+    netOutTask = nullptr;
+    return false;
+  }
+  DEBUG_PRINTLN(F("Network output task started."));
+  return true;
+}
+#endif
+
+// make sure pool entry can hold len bytes
+static bool reserveNetOutPacket(NetOutPacket &pkt, size_t len) {
+  if (pkt.size >= len) return true;
+  uint8_t *data = (uint8_t*)realloc(pkt.data, len);
+  if (!data) return false;
+  pkt.data = data;
+  pkt.size = len;
+  return true;
+}
+
+// returns false if packet could not be queued and has to be sent synchronously (no task, out of memory)
+bool queueRealtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8_t *buffer, uint8_t bri, bool isRGBW) {
+  if (!(apActive || interfacesInited) || !client[0] || !length) return true; // nothing would be sent anyway
+  size_t len = length * (isRGBW?4:3);
+  uint8_t idx;
+#ifdef ARDUINO_ARCH_ESP32
+  if (!initNetworkOutput()) return false;
+  if (xQueueReceive(netOutFree, &idx, 0) != pdTRUE) {
+    netOutDrops++; // task can't keep up, skip this frame for this bus
+    return true;
+  }
+  NetOutPacket &pkt = netOutPool[idx];
+  if (!reserveNetOutPacket(pkt, len)) {
+    xQueueSend(netOutFree, &idx, 0);
+    netOutDrops++; // don't send synchronously, packet buffers in realtimeBroadcast() are owned by the task
+    return true;
+  }
+#else
+  if (netOutCount >= WLED_NETOUT_POOL) {
+    // main loop did not get to send queued packets yet, send the oldest now to make room
+    sendNetOutPacket(netOutPool[netOutHead], true);
+    netOutHead = (netOutHead + 1) % WLED_NETOUT_POOL;
+    netOutCount--;
+    netOutDrops++;
+  }
+  idx = (netOutHead + netOutCount) % WLED_NETOUT_POOL;
+  NetOutPacket &pkt = netOutPool[idx];
+  if (!reserveNetOutPacket(pkt, len)) return false;
+#endif
+  memcpy(pkt.data, buffer, len);
+  pkt.length = length;
+  pkt.client = client;
+  pkt.type   = type;
+  pkt.bri    = bri;
+  pkt.isRGBW = isRGBW;
+  pkt.next   = 0;
+  pkt.queued = micros();
+#ifdef ARDUINO_ARCH_ESP32
+  xQueueSend(netOutReady, &idx, 0);
+#else
+  netOutCount++;
+#endif
+  return true;
+}
+
+// ESP8266: send packets queued during strip.show(); ESP32: handled by network output task
+void handleNetworkOutput() {
+#ifndef ARDUINO_ARCH_ESP32
+  while (netOutCount) {
+    if (!sendNetOutPacket(netOutPool[netOutHead])) return; // paced frame continues in a later loop
+    netOutHead = (netOutHead + 1) % WLED_NETOUT_POOL;
+    netOutCount--;
+    yield();
+  }
+#endif
+}
+
+uint8_t getNetworkOutputQueueDepth() {
+#ifdef ARDUINO_ARCH_ESP32
+  return netOutReady ? uxQueueMessagesWaiting(netOutReady) : 0;
+#else
+  return netOutCount;
+#endif
+}
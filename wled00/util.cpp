@@ -148,8 +148,11 @@ bool oappendi(int i)
 bool oappend(const char* txt)
 {
   uint16_t len = strlen(txt);
-  if (olen + len >= SETTINGS_STACK_BUF_SIZE)
-    return false;        // buffer full
+  if (olen + len >= SETTINGS_STACK_BUF_SIZE) {
+    if (!oflush || len >= SETTINGS_STACK_BUF_SIZE) return false; // buffer full
+    oflush(obuf, olen);
+    olen = 0;
+  }
   strcpy(obuf + olen, txt);
   olen += len;
   return true;
@@ -196,9 +199,15 @@ bool requestJSONBufferLock(uint8_t module)
 {
   unsigned long now = millis();
 
+  jsonLockCount++;
+  if (jsonBufferLock) jsonLockContended++;
   while (jsonBufferLock && millis()-now < 1000) delay(1); // wait for a second for buffer lock
 
-  if (millis()-now >= 1000) {
+  unsigned long waited = millis()-now;
+  jsonLockWaitTotal += waited;
+  if (waited > jsonLockWaitMax) jsonLockWaitMax = waited;
+  if (waited >= 1000) {
+    jsonLockFailed++;
     DEBUG_PRINT(F("ERROR: Locking JSON buffer failed! ("));
     DEBUG_PRINT(jsonBufferLock);
     DEBUG_PRINTLN(")");
@@ -225,6 +234,111 @@ void releaseJSONBufferLock()
 }
 
 
+/*
+ * JSON API commands (HTTP, WebSocket, MQTT) are parsed into a pool of documents instead of the global buffer,
+ * so the network task does not wait for the lock. Commands not requiring a response are queued and applied by
+ * the main loop in order of arrival; the others are applied immediately, after the queued ones.
+ * Producers run in the network task, consumers hold the global JSON buffer lock.
+ */
+static struct {
+  PSRAMDynamicJsonDocument *doc; // allocated on first use (in PSRAM if available) and kept
+  volatile bool used;            // held by a caller or queued
+} jsonPool[JSON_POOL_SIZE];
+static uint8_t jsonQueue[JSON_POOL_SIZE];  // pool slots in order of arrival
+static volatile uint8_t jsonQueueHead = 0; // written by consumer only
+static volatile uint8_t jsonQueueTail = 0; // written by producer only
+
+// returns pool document holding the parsed command or nullptr if none is free, the command is invalid or does not fit
+// (caller falls back to the global buffer)
+JsonDocument* parseJsonCommand(const char *json, size_t len)
+{
+  for (size_t i = 0; i < JSON_POOL_SIZE; i++) {
+    if (jsonPool[i].used) continue;
+    if (!jsonPool[i].doc) {
+      jsonPool[i].doc = new PSRAMDynamicJsonDocument(JSON_CMD_DOC_SIZE);
+      if (jsonPool[i].doc && !jsonPool[i].doc->capacity()) { delete jsonPool[i].doc; jsonPool[i].doc = nullptr; }
+      if (!jsonPool[i].doc) return nullptr;
+    }
+    jsonPool[i].used = true;
+    DeserializationError error = deserializeJson(*jsonPool[i].doc, json, len); // copies strings, input may be freed
+    if (error || !jsonPool[i].doc->is<JsonObject>()) {
+      releaseJsonCommand(jsonPool[i].doc);
+      return nullptr;
+    }
+    return jsonPool[i].doc;
+  }
+  return nullptr;
+}
+
+void releaseJsonCommand(JsonDocument *cmd)
+{
+  for (size_t i = 0; i < JSON_POOL_SIZE; i++) {
+    if (jsonPool[i].doc != cmd) continue;
+    cmd->clear();
+    jsonPool[i].used = false;
+    return;
+  }
+}
+
+// hands a parsed command over to the main loop, cannot overflow as each queued command holds a pool document
+void queueJsonCommand(JsonDocument *cmd)
+{
+  for (size_t i = 0; i < JSON_POOL_SIZE; i++) {
+    if (jsonPool[i].doc != cmd) continue;
+    jsonQueue[jsonQueueTail % JSON_POOL_SIZE] = i;
+    jsonQueueTail++;
+    uint8_t depth = jsonQueueTail - jsonQueueHead;
+    if (depth > jsonCmdQueuePeak) jsonCmdQueuePeak = depth;
+    return;
+  }
+}
+
+// applies queued commands, caller must hold the JSON buffer lock
+static void applyJsonQueue()
+{
+  while (jsonQueueHead != jsonQueueTail) {
+    JsonDocument *cmd = jsonPool[jsonQueue[jsonQueueHead % JSON_POOL_SIZE]].doc;
+    fileDoc = cmd; // for API calls saved as presets
+    deserializeState(cmd->as<JsonObject>());
+    fileDoc = &doc;
+    releaseJsonCommand(cmd);
+    jsonQueueHead++;
+    jsonCmdQueued++;
+  }
+}
+
+// applies command (pool document or global buffer) after the queued ones, caller must hold the JSON buffer lock
+// returns true if the command requests a full state response
+bool applyJsonCommand(JsonDocument *cmd)
+{
+  applyJsonQueue();
+  fileDoc = cmd;
+  bool verbose = deserializeState(cmd->as<JsonObject>());
+  fileDoc = &doc;
+  jsonCmdDirect++;
+  return verbose;
+}
+
+// applies queued commands before a change not going through the queue (binary WebSocket messages)
+// returns false if commands are queued but the JSON buffer lock could not be acquired
+bool flushJsonQueue()
+{
+  if (jsonQueueHead == jsonQueueTail) return true;
+  if (!requestJSONBufferLock(24)) return false;
+  applyJsonQueue();
+  releaseJSONBufferLock();
+  return true;
+}
+
+void handleJsonQueue()
+{
+  if (jsonQueueHead == jsonQueueTail || jsonBufferLock) return; // nothing queued or buffer busy, retry in next loop
+  if (!requestJSONBufferLock(22)) return;
+  applyJsonQueue();
+  releaseJSONBufferLock();
+}
+
+
 // extracts effect mode (or palette) name from names serialized string
 // caller must provide large enough buffer for name (incluing SR extensions)!
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen)
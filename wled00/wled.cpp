@@ -60,6 +60,8 @@ void WLED::loop()
   handleSerial();
   handleImprovWifiScan();
   handleNotifications();
+  handleJsonQueue();
+  handleJsonCache();
   handleTransitions();
 #ifdef WLED_ENABLE_DMX
   handleDMX();
@@ -125,6 +127,7 @@ void WLED::loop()
   #endif
 
   yield();
+  handleNetworkOutput();
 #ifdef ESP8266
   MDNS.update();
 #endif
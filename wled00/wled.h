@@ -176,6 +176,12 @@ using PSRAMDynamicJsonDocument = BasicJsonDocument<PSRAM_Allocator>;
 #include "const.h"
 #include "fcn_declare.h"
 #include "NodeStruct.h"
+#include "jitter_buffer.h"
+#include "clock_sync.h"
+#include "e131_merge.h"
+#include "ws_reassembly.h"
+#include "gzip_writer.h"
+#include "pixel_stream.h"
 #include "pin_manager.h"
 #include "bus_manager.h"
 #include "FX.h"
@@ -366,7 +372,7 @@ WLED_GLOBAL bool simplifiedUI          _INIT(false);   // enable simplified UI
 WLED_GLOBAL byte cacheInvalidate       _INIT(0);       // used to invalidate browser cache when switching from regular to simplified UI
 
 // Sync CONFIG
-WLED_GLOBAL NodesMap Nodes;
+WLED_GLOBAL NodeTable Nodes;
 WLED_GLOBAL bool nodeListEnabled _INIT(true);
 WLED_GLOBAL bool nodeBroadcastEnabled _INIT(true);
 
@@ -395,6 +401,9 @@ WLED_GLOBAL bool notifyAlexa  _INIT(false);                       // send notifi
 WLED_GLOBAL bool notifyMacro  _INIT(false);                       // send notification for macro
 WLED_GLOBAL bool notifyHue    _INIT(true);                        // send notification if Hue light changes
 WLED_GLOBAL uint8_t udpNumRetries _INIT(0);                       // Number of times a UDP sync message is retransmitted. Increase to increase reliability
+WLED_GLOBAL bool syncDelta _INIT(false);                          // send only changes since last notification (with periodic keyframes), older nodes receive keyframes only
+WLED_GLOBAL byte clockSyncMode _INIT(CLOCK_SYNC_OFF);              // share effect timebase with a master node (PTP-like), replaces timebase of notifications
+WLED_GLOBAL ClockSync clockSync;                                  // follower offset filter, reported in /json/info
 
 WLED_GLOBAL bool alexaEnabled _INIT(false);                       // enable device discovery by Amazon Echo
 WLED_GLOBAL char alexaInvocationName[33] _INIT("Light");          // speech control name of device. Choose something voice-to-text can understand
@@ -416,8 +425,10 @@ WLED_GLOBAL uint16_t e131ProxyUniverse _INIT(0);                  // output this
 #endif
 WLED_GLOBAL uint16_t e131Universe _INIT(1);                       // settings for E1.31 (sACN) protocol (only DMX_MODE_MULTIPLE_* can span over consequtive universes)
 WLED_GLOBAL uint16_t e131Port _INIT(5568);                        // DMX in port. E1.31 default is 5568, Art-Net is 6454
-WLED_GLOBAL byte e131Priority _INIT(0);                           // E1.31 port priority (if != 0 priority handling is active)
-WLED_GLOBAL E131Priority highPriority _INIT(3);                   // E1.31 highest priority tracking, init = timeout in seconds
+WLED_GLOBAL byte e131Priority _INIT(0);                           // E1.31 minimum priority, packets below are ignored
+WLED_GLOBAL byte e131MergeMode _INIT(E131_MERGE_LTP);              // combination of equal priority sources of a universe (latest or highest takes precedence)
+WLED_GLOBAL uint16_t e131SourceTimeout _INIT(2500);                // ms without packets until a source is dropped from arbitration (E1.31 network data loss)
+WLED_GLOBAL E131Merge e131Merge;                                  // per universe source tracking
 WLED_GLOBAL byte DMXMode _INIT(DMX_MODE_MULTIPLE_RGB);            // DMX mode (s.a.)
 WLED_GLOBAL uint16_t DMXAddress _INIT(1);                         // DMX start address of fixture, a.k.a. first Channel [for E1.31 (sACN) protocol]
 WLED_GLOBAL uint16_t DMXSegmentSpacing _INIT(0);                  // Number of void/unused channels between each segments DMX channels
@@ -425,6 +436,25 @@ WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect p
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
 WLED_GLOBAL uint16_t pollReplyCount _INIT(0);                     // count number of replies for ArtPoll node report
+WLED_GLOBAL byte ddpJitterDepth _INIT(0);                         // DDP jitter buffer depth in frames (0 = present frames on arrival)
+WLED_GLOBAL JitterBuffer ddpJitter;                               // DDP playout timing, counters are reported in /json/info
+WLED_GLOBAL uint16_t realtimeFrameTimeout _INIT(50);              // ms to wait for DDP push/sync or missing universes before showing incomplete frame (0 = no frame assembly)
+WLED_GLOBAL uint16_t e131OutUniverse _INIT(1);                    // first universe sent by E1.31 network busses
+WLED_GLOBAL byte e131OutPriority _INIT(100);                      // E1.31 output priority
+WLED_GLOBAL uint16_t e131OutSyncUniverse _INIT(0);                // E1.31 sync packet universe sent after each frame (0 = no sync)
+WLED_GLOBAL byte artnetOutNet _INIT(0);                           // Art-Net output net (0-127)
+WLED_GLOBAL byte artnetOutSubnet _INIT(0);                        // Art-Net output subnet (0-15)
+WLED_GLOBAL byte artnetOutUniverse _INIT(0);                      // Art-Net output start universe (0-15), consecutive universes carry into subnet/net
+WLED_GLOBAL uint16_t artnetOutChannels _INIT(510);                // Art-Net output channels per universe (rounded down to whole pixels)
+WLED_GLOBAL bool artnetOutSync _INIT(false);                      // send ArtSync after the last universe of each frame
+WLED_GLOBAL uint16_t artnetOutPacing _INIT(0);                    // delay between Art-Net output packets in us (0 = back to back)
+WLED_GLOBAL volatile uint32_t e131IngestDrops _INIT(0);          // E1.31/Art-Net/DDP packets lost because ingest queue was full
+WLED_GLOBAL volatile uint16_t e131IngestPeak _INIT(0);           // max. E1.31/Art-Net/DDP packets waiting in ingest queue
+WLED_GLOBAL uint32_t udpIngestDeferred _INIT(0);                  // loop iterations that left packets for later because of time budget
+WLED_GLOBAL volatile uint32_t netOutSent _INIT(0);               // network bus frames sent
+WLED_GLOBAL volatile uint32_t netOutDrops _INIT(0);              // network bus frames dropped (ESP8266: sent early) because packet pool was exhausted
+WLED_GLOBAL volatile uint32_t netOutLatency _INIT(0);            // average time from queueing to sent in us
+WLED_GLOBAL volatile uint32_t netOutMaxLatency _INIT(0);         // max time from queueing to sent in us
 
 // mqtt
 WLED_GLOBAL unsigned long lastMqttReconnectAttempt _INIT(0);  // used for other periodic tasks too
@@ -625,6 +655,7 @@ WLED_GLOBAL bool useMainSegmentOnly _INIT(false);
 
 WLED_GLOBAL unsigned long lastInterfaceUpdate _INIT(0);
 WLED_GLOBAL byte interfaceUpdateCallMode _INIT(CALL_MODE_INIT);
+WLED_GLOBAL uint32_t stateVersion _INIT(0); // incremented on every state change (JSON API ETag)
 
 // alexa udp
 WLED_GLOBAL String escapedMac;
@@ -653,6 +684,7 @@ WLED_GLOBAL Toki toki _INIT(Toki());
 // Temp buffer
 WLED_GLOBAL char* obuf;
 WLED_GLOBAL uint16_t olen _INIT(0);
+WLED_GLOBAL void (*oflush)(const char*, size_t) _INIT(nullptr); // if set, full temp buffers are passed on instead of truncating output
 
 // General filesystem
 WLED_GLOBAL size_t fsBytesUsed _INIT(0);
@@ -685,14 +717,15 @@ WLED_GLOBAL AsyncWebServer server _INIT_N(((80)));
 #ifdef WLED_ENABLE_WEBSOCKETS
 WLED_GLOBAL AsyncWebSocket ws _INIT_N((("/ws")));
 #endif
+WLED_GLOBAL uint32_t wsMaxMessageSize _INIT(WS_MAX_MESSAGE_SIZE); // bytes, larger fragmented WS messages are rejected
 WLED_GLOBAL AsyncClient     *hueClient _INIT(NULL);
 WLED_GLOBAL AsyncWebHandler *editHandler _INIT(nullptr);
 
 // udp interface objects
 WLED_GLOBAL WiFiUDP notifierUdp, rgbUdp, notifier2Udp;
 WLED_GLOBAL WiFiUDP ntpUdp;
-WLED_GLOBAL ESPAsyncE131 e131 _INIT_N(((handleE131Packet)));
-WLED_GLOBAL ESPAsyncE131 ddp  _INIT_N(((handleE131Packet)));
+WLED_GLOBAL ESPAsyncE131 e131 _INIT_N(((queueE131Packet)));
+WLED_GLOBAL ESPAsyncE131 ddp  _INIT_N(((queueE131Packet)));
 WLED_GLOBAL bool e131NewData _INIT(false);
 
 // led fx library object
@@ -748,6 +781,14 @@ WLED_GLOBAL int8_t spi_sclk  _INIT(SPISCLKPIN);
 // global ArduinoJson buffer
 WLED_GLOBAL StaticJsonDocument<JSON_BUFFER_SIZE> doc;
 WLED_GLOBAL volatile uint8_t jsonBufferLock _INIT(0);
+WLED_GLOBAL uint32_t jsonLockCount _INIT(0);      // JSON buffer lock requests
+WLED_GLOBAL uint32_t jsonLockContended _INIT(0);  // lock requests that had to wait
+WLED_GLOBAL uint32_t jsonLockFailed _INIT(0);     // lock requests that timed out
+WLED_GLOBAL uint32_t jsonLockWaitTotal _INIT(0);  // ms waited for the lock
+WLED_GLOBAL uint16_t jsonLockWaitMax _INIT(0);    // ms
+WLED_GLOBAL uint32_t jsonCmdQueued _INIT(0);      // API commands applied from the command queue
+WLED_GLOBAL uint32_t jsonCmdDirect _INIT(0);      // API commands applied immediately (response needed, pool exhausted or too large)
+WLED_GLOBAL uint8_t  jsonCmdQueuePeak _INIT(0);
 
 // enable additional debug output
 #if defined(WLED_DEBUG_HOST)
@@ -173,6 +173,17 @@ void handleSerial()
         state = AdaState::Data_Red;
         break;
       case AdaState::Data_Red:
+        if (count > 1 && Serial.available() >= 6) {
+          // read whole pixels at once, the last pixel of the frame goes through the byte states below
+          byte buf[96];
+          uint16_t n = min(min(count - 1, (int)sizeof(buf) / 3), Serial.available() / 3);
+          Serial.readBytes(buf, n * 3);
+          if (!realtimeOverride) setRealtimePixels(pixel, n, buf);
+          pixel += n;
+          count -= n;
+          continuousSendLED = false;
+          continue;
+        }
         red   = next;
         state = AdaState::Data_Green;
         break;
@@ -169,15 +169,56 @@ void initServer()
     serveSettings(request, true);
   });
 
+  server.on("/json/nodes.bin", HTTP_GET, [](AsyncWebServerRequest *request){
+    serveNodesBinary(request);
+  });
+
   server.on("/json", HTTP_GET, [](AsyncWebServerRequest *request){
     serveJson(request);
   });
 
+  // binary pixel data, must be registered before the JSON handler also matching /json/*
+  server.on("/json/pixels", HTTP_POST, [](AsyncWebServerRequest *request){
+    servePixelUpload(request);
+  }, nullptr, [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+    handlePixelUploadBody(request, data, len, index, total);
+  });
+
   AsyncCallbackJsonWebHandler* handler = new AsyncCallbackJsonWebHandler("/json", [](AsyncWebServerRequest *request) {
     bool verboseResponse = false;
     bool isConfig = false;
 
-    if (!requestJSONBufferLock(14)) return;
+    const String& url = request->url();
+    isConfig = url.indexOf("cfg") > -1;
+    if (!isConfig) {
+      // state commands are parsed into the document pool, those not requesting the state back are queued
+      const char *body = (const char*)(request->_tempObject); // not null terminated
+      JsonDocument *cmd = body ? parseJsonCommand(body, request->contentLength()) : nullptr;
+      if (cmd) {
+        JsonObject root = cmd->as<JsonObject>();
+        if (root.containsKey("pin")) checkSettingsPIN(root["pin"].as<const char*>());
+        if (!root["v"]) {
+          queueJsonCommand(cmd);
+        } else {
+          if (!requestJSONBufferLock(14)) {
+            releaseJsonCommand(cmd);
+            request->send(503, "application/json", F("{\"error\":3}")); // ERR_NOBUF
+            return;
+          }
+          verboseResponse = applyJsonCommand(cmd);
+          releaseJSONBufferLock();
+          releaseJsonCommand(cmd);
+          if (verboseResponse) { serveJson(request); return; }
+        }
+        request->send(200, "application/json", F("{\"success\":true}"));
+        return;
+      }
+    }
+
+    if (!requestJSONBufferLock(14)) {
+      request->send(503, "application/json", F("{\"error\":3}")); // ERR_NOBUF
+      return;
+    }
 
     DeserializationError error = deserializeJson(doc, (uint8_t*)(request->_tempObject));
     JsonObject root = doc.as<JsonObject>();
@@ -188,8 +229,6 @@ void initServer()
     }
     if (root.containsKey("pin")) checkSettingsPIN(root["pin"].as<const char*>());
 
-    const String& url = request->url();
-    isConfig = url.indexOf("cfg") > -1;
     if (!isConfig) {
       /*
       #ifdef WLED_DEBUG
@@ -198,7 +237,7 @@ void initServer()
         DEBUG_PRINTLN();
       #endif
       */
-      verboseResponse = deserializeState(root);
+      verboseResponse = applyJsonCommand(&doc);
     } else {
       if (!correctPIN && strlen(settingsPIN)>0) {
         request->send(403, "application/json", F("{\"error\":1}")); // ERR_DENIED
@@ -521,6 +560,58 @@ String dmxProcessor(const String& var)
 #endif
 
 
+/*
+ * Settings JS larger than the temp buffer (many buses or usermods) is sent as chunked response. Instead of keeping
+ * the whole output in heap, it is generated again for every chunk and only the part of the chunk is kept.
+ * Live values (e.g. current draw) are taken once per request so every chunk is generated from the same values.
+ * If the length changes anyway (e.g. a usermod printing a live value), the parts would not fit together and
+ * the response ends early.
+ */
+static struct {
+  uint8_t *dest;  // chunk, nullptr while measuring
+  size_t from;    // offset of the chunk in the output
+  size_t len;     // chunk size
+  size_t pos;     // output generated so far
+  bool flushed;   // output did not fit into the temp buffer
+} settingsOut;
+static const char settingsJSHead[] PROGMEM = "function GetV(){var d=document;";
+
+static void appendSettingsOut(const char *data, size_t len)
+{
+  size_t end = settingsOut.from + settingsOut.len;
+  if (settingsOut.dest && settingsOut.pos + len > settingsOut.from && settingsOut.pos < end) {
+    size_t skip = settingsOut.pos < settingsOut.from ? settingsOut.from - settingsOut.pos : 0;
+    size_t at = settingsOut.pos + skip - settingsOut.from;
+    memcpy(settingsOut.dest + at, data + skip, std::min(len - skip, settingsOut.len - at));
+  }
+  settingsOut.pos += len;
+}
+
+static void flushSettingsOut(const char *data, size_t len)
+{
+  settingsOut.flushed = true;
+  appendSettingsOut(data, len);
+}
+
+// returns length of the settings JS, bytes from .. from+len-1 are copied to dest (if given)
+// buf holds the output of getSettingsJS() if it fit (settingsOut.flushed not set)
+static size_t generateSettingsJS(byte subPage, const SettingsLiveValues &live, char *buf, uint8_t *dest, size_t from, size_t len)
+{
+  settingsOut.dest = dest;
+  settingsOut.from = from;
+  settingsOut.len = len;
+  settingsOut.pos = 0;
+  settingsOut.flushed = false;
+  strcpy_P(buf, settingsJSHead);
+  appendSettingsOut(buf, strlen(buf));
+  oflush = flushSettingsOut;
+  getSettingsJS(subPage, buf, live);
+  oflush = nullptr;
+  appendSettingsOut(buf, olen);
+  appendSettingsOut("}", 1);
+  return settingsOut.pos;
+}
+
 void serveSettingsJS(AsyncWebServerRequest* request)
 {
   char buf[SETTINGS_STACK_BUF_SIZE+37];
@@ -536,10 +627,24 @@ void serveSettingsJS(AsyncWebServerRequest* request)
     request->send(403, "application/javascript", buf);
     return;
   }
-  strcat_P(buf,PSTR("function GetV(){var d=document;"));
-  getSettingsJS(subPage, buf+strlen(buf));  // this may overflow by 35bytes!!!
-  strcat_P(buf,PSTR("}"));
-  request->send(200, "application/javascript", buf);
+
+  SettingsLiveValues live = getSettingsLiveValues();
+  size_t total = generateSettingsJS(subPage, live, buf, nullptr, 0, 0);
+  if (!settingsOut.flushed) { // fits, send as a whole
+    size_t headLen = strlen_P(settingsJSHead);
+    memmove(buf + headLen, buf, olen);
+    memcpy_P(buf, settingsJSHead, headLen);
+    buf[headLen + olen] = 0;
+    strcat_P(buf,PSTR("}"));
+    request->send(200, "application/javascript", buf);
+    return;
+  }
+  request->send(request->beginChunkedResponse("application/javascript", [subPage, live, total](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+    if (index >= total) return 0;
+    char buf[SETTINGS_STACK_BUF_SIZE+37];
+    if (generateSettingsJS(subPage, live, buf, buffer, index, maxLen) != total) return 0; // changed meanwhile, see above
+    return std::min(maxLen, total - index);
+  }));
 }
 
 
@@ -7,83 +7,292 @@
 
 uint16_t wsLiveClientId = 0;
 unsigned long wsLastLiveTime = 0;
-//uint8_t* wsFrameBuffer = nullptr;
 
 #define WS_LIVE_INTERVAL 40
 
+static bool addLiveClient(uint32_t id);
+static void stopLiveClient(uint32_t id);
+static void handleLiveAck(uint32_t id, uint8_t seq);
+static void trackWsClient(uint32_t id, bool connected);
+static bool setWsClientDiff(uint32_t id, bool diff);
+
+static WsReassembly wsReassembly; // messages arriving in several frames or packets
+
+/*
+ * Binary control messages for high-rate controllers, applied directly without JSON parsing. JSON commands queued
+ * before are applied first (only then the JSON buffer lock is needed). Byte 0 is the opcode, <seg> 255 means all
+ * selected segments:
+ *   0x01 brightness  [bri]                      0 turns off
+ *   0x02 power       [0 off | 1 on | 2 toggle]
+ *   0x03 color       [seg, slot, r, g, b(, w)]  slot 0-2 (primary, secondary, tertiary)
+ *   0x04 effect      [seg, fx, sx, ix, pal(, c1, c2, c3)]
+ *   0x05 pixels RGB  [seg, start hi, start lo, r, g, b, ...]  like "i", freezes the segment
+ *   0x06 pixels RGBW [seg, start hi, start lo, r, g, b, w, ...]
+ *   0x07 preset      [id]
+ *   0x08 pixel data  [seg, format, start hi, start lo, ...]  raw, RLE or palette indexed, see pixel_stream.h
+ *   0x09 frame       [name...]                  applies a frame stored with POST /json/pixels?frame=<name>
+ * Nothing is sent back on success, malformed or out of range messages are answered with ['E', opcode].
+ * 'A' is used by the live view acknowledgement.
+ */
+#define WS_BIN_BRI         0x01
+#define WS_BIN_POWER       0x02
+#define WS_BIN_COLOR       0x03
+#define WS_BIN_EFFECT      0x04
+#define WS_BIN_PIXELS_RGB  0x05
+#define WS_BIN_PIXELS_RGBW 0x06
+#define WS_BIN_PRESET      0x07
+#define WS_BIN_PIXEL_DATA  0x08
+#define WS_BIN_FRAME       0x09
+#define WS_BIN_ALL_SEGMENTS 255
+
+// unfreeze all segments when turning on (as JSON API)
+static void unfreezeSegments()
+{
+  for (size_t s = 0; s < strip.getSegmentsNum(); s++) strip.getSegment(s).freeze = false;
+  if (realtimeMode && !realtimeOverride && useMainSegmentOnly) strip.getMainSegment().freeze = true; // keep live segment frozen if live
+}
+
+// returns false if the message is invalid, nothing is changed if only checked
+static bool applyBinarySegment(Segment &seg, const uint8_t *data, size_t len, bool checkOnly = false)
+{
+  switch (data[0]) {
+    case WS_BIN_COLOR: {
+      if (len != 6 && len != 7) return false;
+      if (data[2] >= NUM_COLORS) return false;
+      if (checkOnly) return true;
+      uint32_t c = RGBW32(data[3], data[4], data[5], len > 6 ? data[6] : 0);
+      if (seg.colors[data[2]] != c) {
+        seg.setColor(data[2], c);
+        stateChanged = true;
+      }
+      return true;
+    }
+    case WS_BIN_EFFECT: {
+      if (len != 6 && len != 9) return false;
+      if (data[2] >= strip.getModeCount()) return false;
+      if (checkOnly) return true;
+      if (data[2] != seg.mode) {
+        if (currentPlaylist >= 0) unloadPlaylist();
+        seg.setMode(data[2]);
+        stateChanged = true;
+      }
+      if (seg.speed != data[3] || seg.intensity != data[4]) stateChanged = true;
+      seg.speed     = data[3];
+      seg.intensity = data[4];
+      if ((seg.getLightCapabilities() & 1) && data[5] != seg.palette) { // ignore palette for White and On/Off segments
+        seg.setPalette(data[5]);
+        stateChanged = true;
+      }
+      if (len > 6) {
+        if (seg.custom1 != data[6] || seg.custom2 != data[7] || seg.custom3 != constrain(data[8], 0, 31)) stateChanged = true;
+        seg.custom1 = data[6];
+        seg.custom2 = data[7];
+        seg.custom3 = constrain(data[8], 0, 31);
+      }
+      return true;
+    }
+    case WS_BIN_PIXELS_RGB:
+    case WS_BIN_PIXELS_RGBW: {
+      size_t bpp = data[0] == WS_BIN_PIXELS_RGBW ? 4 : 3;
+      if (len < 4 || (len - 4) % bpp) return false;
+      uint8_t oldMap1D2D = seg.map1D2D;
+      seg.map1D2D = M12_Pixels; // no mapping
+      size_t start = (data[2] << 8) | data[3];
+      size_t count = (len - 4) / bpp;
+      size_t segLen = seg.virtualLength();
+      if (start + count > segLen || checkOnly) { seg.map1D2D = oldMap1D2D; return start + count <= segLen; }
+
+      // set brightness immediately and disable transition
+      transitionDelayTemp = 0;
+      jsonTransitionOnce = true;
+      strip.setBrightness(scaledBri(bri), true);
+      if (!seg.freeze) { // freeze and init to black
+        seg.freeze = true;
+        seg.fill(BLACK);
+      }
+      const uint8_t *px = data + 4;
+      for (size_t i = 0; i < count; i++, px += bpp) {
+        seg.setPixelColor(start + i, gamma32(RGBW32(px[0], px[1], px[2], bpp > 3 ? px[3] : 0)));
+      }
+      seg.map1D2D = oldMap1D2D; // restore mapping
+      strip.trigger(); // force segment update
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool handleWsBinary(const uint8_t *data, size_t len)
+{
+  if (!flushJsonQueue()) return false; // keep order with JSON commands
+  switch (data[0]) {
+    case WS_BIN_BRI:
+      if (len != 2) return false;
+      if (data[1] && !bri) unfreezeSegments();
+      bri = data[1];
+      break;
+    case WS_BIN_POWER:
+      if (len != 2 || data[1] > 2) return false;
+      if (data[1] == 2 || !data[1] != !bri) {
+        toggleOnOff();
+        if (bri) unfreezeSegments();
+      }
+      break;
+    case WS_BIN_PRESET:
+      if (len != 2 || data[1] == 0 || data[1] > 250) return false;
+      presetCycCurr = data[1];
+      unloadPlaylist();                               // applying a preset unloads the playlist
+      applyPreset(data[1], CALL_MODE_DIRECT_CHANGE);  // async load from file system
+      return true;
+    case WS_BIN_PIXEL_DATA:
+      return applyPixelData(data + 1, len - 1);       // state updated if pixels were set
+    case WS_BIN_FRAME: {
+      char name[32];
+      if (len < 2 || len > sizeof(name)) return false;
+      memcpy(name, data + 1, len - 1);
+      name[len - 1] = 0;
+      return applyPixelFrame(name);
+    }
+    case WS_BIN_COLOR:
+    case WS_BIN_EFFECT:
+    case WS_BIN_PIXELS_RGB:
+    case WS_BIN_PIXELS_RGBW:
+      if (len < 2) return false;
+      if (data[1] == WS_BIN_ALL_SEGMENTS) {
+        // check all segments first, so an invalid message changes none of them
+        for (size_t s = 0; s < strip.getSegmentsNum(); s++) {
+          Segment &seg = strip.getSegment(s);
+          if (seg.isActive() && seg.isSelected() && !applyBinarySegment(seg, data, len, true)) return false;
+        }
+        for (size_t s = 0; s < strip.getSegmentsNum(); s++) {
+          Segment &seg = strip.getSegment(s);
+          if (seg.isActive() && seg.isSelected()) applyBinarySegment(seg, data, len);
+        }
+      } else {
+        if (data[1] >= strip.getSegmentsNum()) return false;
+        if (!applyBinarySegment(strip.getSegment(data[1]), data, len)) return false;
+      }
+      break;
+    default:
+      return false;
+  }
+  stateUpdated(CALL_MODE_DIRECT_CHANGE);
+  return true;
+}
+
+// handles a complete message (single frame or reassembled)
+static void handleWsMessage(AsyncWebSocketClient * client, uint8_t opcode, uint8_t *data, size_t len)
+{
+  if(opcode == WS_BINARY && len == 2 && data[0] == 'A') {
+    handleLiveAck(client->id(), data[1]); // delta live view acknowledgement
+    return;
+  }
+  if(opcode == WS_BINARY && len > 0) {
+    if (!handleWsBinary(data, len)) {
+      uint8_t err[2] = {'E', data[0]};
+      client->binary(err, sizeof(err));
+    }
+    return;
+  }
+  if(opcode == WS_TEXT)
+  {
+    if (len > 0 && len < 10 && data[0] == 'p') {
+      // application layer ping/pong heartbeat.
+      // client-side socket layer ping packets are unresponded (investigate)
+      client->text(F("pong"));
+      return;
+    }
+
+    bool verboseResponse = false;
+    JsonDocument *cmd = parseJsonCommand((const char*)data, len); // pooled, no need to wait for the global buffer
+    if (!cmd) {
+      if (!requestJSONBufferLock(11)) return;
+      cmd = &doc;
+      DeserializationError error = deserializeJson(doc, data, len);
+      if (error || doc.as<JsonObject>().isNull()) {
+        releaseJSONBufferLock();
+        return;
+      }
+    }
+    bool locked = (cmd == &doc);
+    JsonObject root = cmd->as<JsonObject>();
+    if (root["v"] && root.size() == 1) {
+      //if the received value is just "{"v":true}", send only to this client
+      verboseResponse = true;
+    } else if (root.containsKey("diff")) {
+      setWsClientDiff(client->id(), root["diff"]);
+      verboseResponse = true; // full state as base for patches
+    } else if (root.containsKey("lv")) {
+      if (root["lv"].as<int>() == 3) {
+        if (wsLiveClientId == client->id()) wsLiveClientId = 0;
+        if (!addLiveClient(client->id())) {
+          if (locked) releaseJSONBufferLock(); else releaseJsonCommand(cmd);
+          client->text(F("{\"error\":3}")); // too many live view clients
+          return;
+        }
+      } else {
+        stopLiveClient(client->id());
+        wsLiveClientId = root["lv"] ? client->id() : 0;
+      }
+    } else if (!locked && !root["v"]) {
+      queueJsonCommand(cmd); // applied by main loop
+      if (!interfaceUpdateCallMode) client->text(F("{\"success\":true}"));
+      return;
+    } else {
+      if (!locked) locked = requestJSONBufferLock(11); // pooled command needs the lock only while applied
+      if (locked) verboseResponse = applyJsonCommand(cmd);
+    }
+    if (cmd != &doc) releaseJsonCommand(cmd);
+    if (locked) releaseJSONBufferLock(); // will clean fileDoc
+
+    if (!interfaceUpdateCallMode) { // individual client response only needed if no WS broadcast soon
+      if (verboseResponse) {
+        sendDataWs(client);
+      } else {
+        // we have to send something back otherwise WS connection closes
+        client->text(F("{\"success\":true}"));
+      }
+      // force broadcast in 500ms after updating client
+      //lastInterfaceUpdate = millis() - (INTERFACE_UPDATE_COOLDOWN -500); // ESP8266 does not like this
+    }
+  }
+}
+
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
   if(type == WS_EVT_CONNECT){
     //client connected
     DEBUG_PRINTLN(F("WS client connected."));
+    trackWsClient(client->id(), true);
     sendDataWs(client);
   } else if(type == WS_EVT_DISCONNECT){
     //client disconnected
     if (client->id() == wsLiveClientId) wsLiveClientId = 0;
+    trackWsClient(client->id(), false);
+    wsReassembly.release(client->id());
     DEBUG_PRINTLN(F("WS client disconnected."));
   } else if(type == WS_EVT_DATA){
     // data packet
     AwsFrameInfo * info = (AwsFrameInfo*)arg;
-    if(info->final && info->index == 0 && info->len == len){
+    if(info->final && info->index == 0 && info->len == len && info->num == 0){
       // the whole message is in a single frame and we got all of its data (max. 1450 bytes)
-      if(info->opcode == WS_TEXT)
-      {
-        if (len > 0 && len < 10 && data[0] == 'p') {
-          // application layer ping/pong heartbeat.
-          // client-side socket layer ping packets are unresponded (investigate)
-          client->text(F("pong"));
-          return;
-        }
-
-        bool verboseResponse = false;
-        if (!requestJSONBufferLock(11)) return;
-
-        DeserializationError error = deserializeJson(doc, data, len);
-        JsonObject root = doc.as<JsonObject>();
-        if (error || root.isNull()) {
-          releaseJSONBufferLock();
-          return;
-        }
-        if (root["v"] && root.size() == 1) {
-          //if the received value is just "{"v":true}", send only to this client
-          verboseResponse = true;
-        } else if (root.containsKey("lv")) {
-          wsLiveClientId = root["lv"] ? client->id() : 0;
-        } else {
-          verboseResponse = deserializeState(root);
-        }
-        releaseJSONBufferLock(); // will clean fileDoc
-
-        if (!interfaceUpdateCallMode) { // individual client response only needed if no WS broadcast soon
-          if (verboseResponse) {
-            sendDataWs(client);
-          } else {
-            // we have to send something back otherwise WS connection closes
-            client->text(F("{\"success\":true}"));
-          }
-          // force broadcast in 500ms after updating client
-          //lastInterfaceUpdate = millis() - (INTERFACE_UPDATE_COOLDOWN -500); // ESP8266 does not like this
-        }
-      }
+      handleWsMessage(client, info->opcode, data, len);
     } else {
       //message is comprised of multiple frames or the frame is split into multiple packets
-      //if(info->index == 0){
-        //if (!wsFrameBuffer && len < 4096) wsFrameBuffer = new uint8_t[4096];
-      //}
-
-      //if (wsFrameBuffer && len < 4096 && info->index + info->)
-      //{
-
-      //}
-
-      if((info->index + len) == info->len){
-        if(info->final){
-          if(info->message_opcode == WS_TEXT) {
-            client->text(F("{\"error\":9}")); // ERR_JSON we do not handle split packets right now
-          }
-        }
+      uint8_t *msg;
+      size_t msgLen;
+      uint8_t opcode;
+      switch (wsReassembly.feed(client->id(), info->opcode, info->num, info->final, info->index, info->len, data, len, wsMaxMessageSize, &msg, &msgLen, &opcode)) {
+        case WS_FRAGMENT_COMPLETE:
+          DEBUG_PRINTF("WS multipart message (%u bytes).\n", msgLen);
+          handleWsMessage(client, opcode, msg, msgLen);
+          wsReassembly.release(client->id());
+          break;
+        case WS_FRAGMENT_ERROR:
+          DEBUG_PRINTLN(F("WS multipart message dropped."));
+          if (info->message_opcode == WS_TEXT) client->text(F("{\"error\":9}")); // ERR_JSON too large (or out of memory)
+          break;
       }
-      DEBUG_PRINTLN(F("WS multipart message."));
     }
   } else if(type == WS_EVT_ERROR){
     //error was received from the other end
@@ -96,6 +305,168 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
   }
 }
 
+/*
+ * State patches: clients that sent {"diff":true} receive {"sp":{...}} on state changes, holding only the
+ * top level state keys and segments that changed since the last broadcast (removed segments as {"id":n,"stop":0}).
+ * Changes are detected by comparing hashes of the serialized keys and segments, so every place modifying
+ * state is covered. Hashes are only kept while a client uses patches. A full state & info snapshot is sent
+ * to all clients at least every WS_SNAPSHOT_INTERVAL, also without state changes, so lost patches get repaired.
+ */
+#define WS_MAX_TRACKED_CLIENTS 8
+#define WS_STATE_KEYS 24            // top level state keys tracked (more are always sent)
+#define WS_SNAPSHOT_INTERVAL 10000  // ms
+
+static uint32_t wsClientIds[WS_MAX_TRACKED_CLIENTS];  // connected clients, 0 = unused
+static bool     wsClientDiff[WS_MAX_TRACKED_CLIENTS]; // client wants state patches
+static uint32_t wsKeyHash[WS_STATE_KEYS];             // hash of key name, 0 = unused
+static uint32_t wsValueHash[WS_STATE_KEYS];           // hash of serialized value at last broadcast
+static uint32_t wsSegHash[32];                        // hash of serialized segment, 0 = not present
+static unsigned long wsLastSnapshot = 0;
+static volatile bool wsHashesStale = true;            // set by WS task, hashes are reset by next broadcast
+
+static void trackWsClient(uint32_t id, bool connected)
+{
+  for (size_t i = 0; i < WS_MAX_TRACKED_CLIENTS; i++) {
+    if (connected && !wsClientIds[i]) { wsClientDiff[i] = false; wsClientIds[i] = id; return; }
+    if (!connected && wsClientIds[i] == id) { wsClientIds[i] = 0; return; }
+  }
+}
+
+static size_t countWsDiffClients()
+{
+  size_t n = 0;
+  for (size_t i = 0; i < WS_MAX_TRACKED_CLIENTS; i++) if (wsClientIds[i] && wsClientDiff[i]) n++;
+  return n;
+}
+
+static bool setWsClientDiff(uint32_t id, bool diff)
+{
+  for (size_t i = 0; i < WS_MAX_TRACKED_CLIENTS; i++) {
+    if (wsClientIds[i] != id) continue;
+    if (diff && !countWsDiffClients()) wsHashesStale = true; // hashes were not kept without diff clients
+    wsClientDiff[i] = diff;
+    return true;
+  }
+  return false;
+}
+
+// FNV-1a of serialized JSON
+class HashPrint : public Print {
+  public:
+    uint32_t hash = 2166136261UL;
+    using Print::write;
+    size_t write(uint8_t c) override { hash = (hash ^ c) * 16777619UL; return 1; }
+};
+
+static uint32_t hashJson(JsonVariantConst v)
+{
+  HashPrint hp;
+  serializeJson(v, hp);
+  return hp.hash | 1; // never 0
+}
+
+static int findStateKey(const char *key, bool create)
+{
+  uint32_t h = 2166136261UL;
+  for (const char *c = key; *c; c++) h = (h ^ *c) * 16777619UL;
+  h |= 1;
+  int freeSlot = -1;
+  for (size_t i = 0; i < WS_STATE_KEYS; i++) {
+    if (wsKeyHash[i] == h) return i;
+    if (!wsKeyHash[i] && freeSlot < 0) freeSlot = i;
+  }
+  if (create && freeSlot >= 0) { wsKeyHash[freeSlot] = h; wsValueHash[freeSlot] = 0; }
+  return create ? freeSlot : -1;
+}
+
+static inline size_t wsAppend(char *dst, size_t pos, const char *str)
+{
+  size_t len = strlen(str);
+  if (dst) memcpy(dst + pos, str, len);
+  return len;
+}
+
+// measures (dst == nullptr) or writes patch of the keys and segments marked as changed
+static size_t writeStatePatch(char *dst, size_t cap, JsonObject state, uint32_t keys, uint32_t segs, uint32_t removed)
+{
+  size_t pos = 0;
+  bool first = true;
+  pos += wsAppend(dst, pos, "{\"sp\":{");
+  for (JsonPair kv : state) {
+    if (kv.key() == "seg") continue;
+    int slot = findStateKey(kv.key().c_str(), false);
+    if (slot >= 0 && !(keys & (1UL << slot))) continue;
+    if (!first) pos += wsAppend(dst, pos, ",");
+    first = false;
+    pos += wsAppend(dst, pos, "\"");
+    pos += wsAppend(dst, pos, kv.key().c_str());
+    pos += wsAppend(dst, pos, "\":");
+    pos += dst ? serializeJson(kv.value(), dst + pos, cap - pos) : measureJson(kv.value());
+  }
+  if (segs || removed) {
+    if (!first) pos += wsAppend(dst, pos, ",");
+    pos += wsAppend(dst, pos, "\"seg\":[");
+    bool firstSeg = true;
+    for (JsonObject seg : state["seg"].as<JsonArray>()) {
+      unsigned id = seg["id"];
+      if (id < 32 && !(segs & (1UL << id))) continue;
+      if (!firstSeg) pos += wsAppend(dst, pos, ",");
+      firstSeg = false;
+      pos += dst ? serializeJson(seg, dst + pos, cap - pos) : measureJson(seg);
+    }
+    for (unsigned id = 0; id < 32; id++) {
+      if (!(removed & (1UL << id))) continue;
+      char tmp[24];
+      sprintf_P(tmp, PSTR("%s{\"id\":%u,\"stop\":0}"), firstSeg ? "" : ",", id);
+      firstSeg = false;
+      pos += wsAppend(dst, pos, tmp);
+    }
+    pos += wsAppend(dst, pos, "]");
+  }
+  pos += wsAppend(dst, pos, "}}");
+  return pos;
+}
+
+// compares state with last broadcast and updates hashes, returns true if anything changed
+static bool updateStateHashes(JsonObject state, uint32_t &keys, uint32_t &segs, uint32_t &removed)
+{
+  uint32_t present = 0, seen = 0;
+  keys = segs = removed = 0;
+  for (JsonPair kv : state) {
+    if (kv.key() == "seg") continue;
+    int slot = findStateKey(kv.key().c_str(), true);
+    if (slot < 0) { keys = UINT32_MAX; continue; } // untracked key, always sent
+    seen |= 1UL << slot;
+    uint32_t h = hashJson(kv.value());
+    if (h != wsValueHash[slot]) { keys |= 1UL << slot; wsValueHash[slot] = h; }
+  }
+  for (size_t i = 0; i < WS_STATE_KEYS; i++) if (!(seen & (1UL << i))) wsKeyHash[i] = 0; // key disappeared, resend when it reappears
+  for (JsonObject seg : state["seg"].as<JsonArray>()) {
+    unsigned id = seg["id"];
+    if (id >= 32) { segs = UINT32_MAX; continue; }
+    present |= 1UL << id;
+    uint32_t h = hashJson(seg);
+    if (h != wsSegHash[id]) { segs |= 1UL << id; wsSegHash[id] = h; }
+  }
+  for (unsigned id = 0; id < 32; id++) {
+    if (wsSegHash[id] && !(present & (1UL << id))) { removed |= 1UL << id; wsSegHash[id] = 0; }
+  }
+  return keys || segs || removed;
+}
+
+// returns patch of changes since last broadcast or nullptr if nothing changed (or out of memory)
+static AsyncWebSocketMessageBuffer * makeStatePatch(JsonObject state)
+{
+  uint32_t keys, segs, removed;
+  if (!updateStateHashes(state, keys, segs, removed)) return nullptr;
+
+  size_t len = writeStatePatch(nullptr, 0, state, keys, segs, removed);
+  AsyncWebSocketMessageBuffer * buffer = ws.makeBuffer(len);
+  if (!buffer) return nullptr;
+  writeStatePatch((char *)buffer->get(), len + 1, state, keys, segs, removed);
+  return buffer;
+}
+
 void sendDataWs(AsyncWebSocketClient * client)
 {
   if (!ws.count()) return;
@@ -105,6 +476,45 @@ void sendDataWs(AsyncWebSocketClient * client)
 
   JsonObject state = doc.createNestedObject("state");
   serializeState(state);
+
+  // broadcast: patch for diff clients, full state only for the others unless a snapshot is due
+  size_t tracked = 0, diffClients = 0;
+  for (size_t i = 0; i < WS_MAX_TRACKED_CLIENTS; i++) {
+    if (!wsClientIds[i]) continue;
+    tracked++;
+    if (wsClientDiff[i]) diffClients++;
+  }
+  bool patchOnly = false;
+  if (!client && diffClients) {
+    if (wsHashesStale) { // first diff client: start from a snapshot
+      wsHashesStale = false;
+      memset(wsKeyHash, 0, sizeof(wsKeyHash));
+      memset(wsSegHash, 0, sizeof(wsSegHash));
+      wsLastSnapshot = millis() - WS_SNAPSHOT_INTERVAL;
+    }
+    if (tracked == ws.count() && millis() - wsLastSnapshot < WS_SNAPSHOT_INTERVAL) {
+      AsyncWebSocketMessageBuffer * patch = makeStatePatch(state);
+      patchOnly = true;
+      if (patch) {
+        patch->lock();
+        for (size_t i = 0; i < WS_MAX_TRACKED_CLIENTS; i++) {
+          AsyncWebSocketClient * wsc = wsClientDiff[i] ? ws.client(wsClientIds[i]) : nullptr;
+          if (wsc) wsc->text(patch);
+        }
+        patch->unlock();
+      }
+      if (diffClients == tracked) { // nobody needs the full state
+        ws._cleanBuffers();
+        releaseJSONBufferLock();
+        return;
+      }
+    } else {
+      uint32_t keys, segs, removed;
+      updateStateHashes(state, keys, segs, removed); // snapshot is the new base
+      wsLastSnapshot = millis();
+    }
+  }
+
   JsonObject info  = doc.createNestedObject("info");
   serializeInfo(info);
 
@@ -142,6 +552,12 @@ void sendDataWs(AsyncWebSocketClient * client)
   if (client) {
     client->text(buffer);
     DEBUG_PRINTLN(F("to a single client."));
+  } else if (patchOnly) {
+    for (size_t i = 0; i < WS_MAX_TRACKED_CLIENTS; i++) {
+      AsyncWebSocketClient * wsc = (wsClientIds[i] && !wsClientDiff[i]) ? ws.client(wsClientIds[i]) : nullptr;
+      if (wsc) wsc->text(buffer);
+    }
+    DEBUG_PRINTLN(F("to clients without state patches."));
   } else {
     ws.textAll(buffer);
     DEBUG_PRINTLN(F("to multiple clients."));
@@ -152,51 +568,54 @@ void sendDataWs(AsyncWebSocketClient * client)
   releaseJSONBufferLock();
 }
 
-bool sendLiveLedsWs(uint32_t wsClient)
-{
-  AsyncWebSocketClient * wsc = ws.client(wsClient);
-  if (!wsc || wsc->queueLength() > 0) return false; //only send if queue free
-
-  size_t used = strip.getLengthTotal();
 #ifdef ESP8266
-  const size_t MAX_LIVE_LEDS_WS = 256U;
+  #define MAX_LIVE_LEDS_WS 256U
+  #define MAX_LIVE_LEDS_WS_DELTA 512U  // per frame buffer of delta clients
+  #define WS_LIVE_TOTAL_LEDS 1024U     // shared by the frame buffers of all delta clients
+  #define WS_LIVE_MAX_CLIENTS 2
 #else
-  const size_t MAX_LIVE_LEDS_WS = 1024U;
+  #define MAX_LIVE_LEDS_WS 1024U
+  #define MAX_LIVE_LEDS_WS_DELTA 4096U
+  #define WS_LIVE_TOTAL_LEDS 4096U     // 24k frame buffers (PSRAM if available) and up to 12k in flight
+  #define WS_LIVE_MAX_CLIENTS 4
 #endif
-  size_t n = ((used -1)/MAX_LIVE_LEDS_WS) +1; //only serve every n'th LED if count over MAX_LIVE_LEDS_WS
-  size_t pos = (strip.isMatrix ? 4 : 2);  // start of data
-  size_t bufSize = pos + (used/n)*3;
 
-  AsyncWebSocketMessageBuffer * wsBuf = ws.makeBuffer(bufSize);
-  if (!wsBuf) return false; //out of memory
-  uint8_t* buffer = wsBuf->get();
-  buffer[0] = 'L';
-  buffer[1] = 1; //version
+// picks every n'th LED (2D: every n'th column of every n'th row) so that at most maxLeds are sent
+struct LiveSampling {
+  size_t n;
+  size_t count;           // LEDs sent (width*height for 2D)
+  uint16_t width, height; // 0 if not 2D
+};
 
+static LiveSampling getLiveSampling(size_t maxLeds)
+{
+  LiveSampling ls;
+  size_t used = strip.getLengthTotal();
+  ls.n = ((used -1)/maxLeds) +1; //only serve every n'th LED if count over maxLeds
+  ls.count = used/ls.n;
+  ls.width = ls.height = 0;
 #ifndef WLED_DISABLE_2D
-  size_t skipLines = 0;
   if (strip.isMatrix) {
-    buffer[1] = 2; //version
-    buffer[2] = Segment::maxWidth;
-    buffer[3] = Segment::maxHeight;
-    if (used > MAX_LIVE_LEDS_WS*4) {
-      buffer[2] = Segment::maxWidth/4;
-      buffer[3] = Segment::maxHeight/4;
-      skipLines = 3;
-    } else if (used > MAX_LIVE_LEDS_WS) {
-      buffer[2] = Segment::maxWidth/2;
-      buffer[3] = Segment::maxHeight/2;
-      skipLines = 1;
+    for (ls.n = 1; ; ls.n++) {
+      ls.width  = (Segment::maxWidth  + ls.n - 1) / ls.n;
+      ls.height = (Segment::maxHeight + ls.n - 1) / ls.n;
+      if ((size_t)ls.width * ls.height <= maxLeds) break;
     }
+    ls.count = ls.width * ls.height;
   }
 #endif
+  return ls;
+}
 
-  for (size_t i = 0; pos < bufSize -2; i += n)
+// writes ls.count RGB pixels as seen (white added, brightness applied)
+static void writeLiveLeds(uint8_t *buffer, const LiveSampling &ls)
+{
+  size_t pos = 0;
+  for (size_t p = 0; p < ls.count; p++)
   {
+    size_t i = p * ls.n;
 #ifndef WLED_DISABLE_2D
-    if (strip.isMatrix && skipLines) {
-      if ((i/Segment::maxWidth)%(skipLines+1)) i += Segment::maxWidth * skipLines;
-    }
+    if (ls.width) i = (p / ls.width) * ls.n * Segment::maxWidth + (p % ls.width) * ls.n; // row major
 #endif
     uint32_t c = strip.getPixelColor(i);
     uint8_t r = R(c);
@@ -207,11 +626,244 @@ bool sendLiveLedsWs(uint32_t wsClient)
     buffer[pos++] = scale8(qadd8(w, g), strip.getBrightness()); //G
     buffer[pos++] = scale8(qadd8(w, b), strip.getBrightness()); //B
   }
+}
+
+bool sendLiveLedsWs(uint32_t wsClient)
+{
+  AsyncWebSocketClient * wsc = ws.client(wsClient);
+  if (!wsc || wsc->queueLength() > 0) return false; //only send if queue free
+
+  LiveSampling ls = getLiveSampling(MAX_LIVE_LEDS_WS);
+  size_t pos = (strip.isMatrix ? 4 : 2);  // start of data
+  size_t bufSize = pos + ls.count*3;
+
+  AsyncWebSocketMessageBuffer * wsBuf = ws.makeBuffer(bufSize);
+  if (!wsBuf) return false; //out of memory
+  uint8_t* buffer = wsBuf->get();
+  buffer[0] = 'L';
+  buffer[1] = 1; //version
+
+#ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) {
+    buffer[1] = 2; //version
+    buffer[2] = ls.width;
+    buffer[3] = ls.height;
+  }
+#endif
+  writeLiveLeds(buffer + pos, ls);
 
   wsc->binary(wsBuf);
   return true;
 }
 
+/*
+ * Delta live view (version 3), requested with {"lv":3}, any number of clients up to WS_LIVE_MAX_CLIENTS
+ * Header: [0] 'L' [1] 3 [2] frame type (0 keyframe, 1 delta) [3] sequence [4] base sequence
+ *         [5-6] LED count (width*height for 2D) [7-8] width [9-10] height (0 if not 2D), all big endian
+ * Keyframe: RGB for every LED.
+ * Delta: XOR against frame <base sequence> as runs, control byte 0x80|(n-1) skips n unchanged LEDs,
+ *        n-1 (< 0x80) is followed by n XOR-ed RGB triplets.
+ * Client acknowledges every frame with binary message ['A', sequence]. Only one frame is in flight per
+ * client, the next one is sent after the ack and the client's interval, which grows while its WS queue
+ * is congested and shrinks again while frames get through. An unacknowledged frame is resent as keyframe.
+ * Clients share WS_LIVE_TOTAL_LEDS, the more clients the coarser the sampling.
+ * WS events may arrive in another task: they only set request/flag fields, clients are added, removed and
+ * acknowledged (and buffers allocated and freed) in handleLiveClients().
+ */
+#define WS_LIVE_HEADER 11
+#define WS_LIVE_KEYFRAME 0
+#define WS_LIVE_DELTA 1
+#define WS_LIVE_MAX_INTERVAL 1000  //ms, slowest frame pacing
+#define WS_LIVE_ACK_TIMEOUT 1000   //ms until a frame is considered lost
+
+struct LiveClient {
+  uint32_t id;            // 0 = unused
+  uint8_t *frames;        // allocation holding both frames
+  uint8_t *base;          // last acknowledged frame (RGB)
+  uint8_t *sent;          // frame in flight
+  uint16_t count;         // LEDs per frame
+  uint16_t interval;      // ms between frames
+  unsigned long lastSent;
+  uint8_t  seq;           // sequence of frame in flight
+  uint8_t  baseSeq;
+  bool     hasBase;
+  bool     inFlight;
+  volatile bool    stop;   // client no longer wants live data (set by WS task)
+  volatile bool    acked;  // ack received (set by WS task)
+  volatile uint8_t ackSeq;
+};
+static LiveClient liveClients[WS_LIVE_MAX_CLIENTS];
+static volatile uint32_t liveClientRequests[WS_LIVE_MAX_CLIENTS]; // ids to add (set by WS task)
+
+static LiveClient* findLiveClient(uint32_t id)
+{
+  for (size_t i = 0; i < WS_LIVE_MAX_CLIENTS; i++) if (liveClients[i].id == id) return &liveClients[i];
+  return nullptr;
+}
+
+static void removeLiveClient(uint32_t id)
+{
+  LiveClient *lc = findLiveClient(id);
+  if (!lc) return;
+  free(lc->frames);
+  memset(lc, 0, sizeof(LiveClient));
+}
+
+static void stopLiveClient(uint32_t id)
+{
+  LiveClient *lc = findLiveClient(id);
+  if (lc) lc->stop = true;
+  for (size_t i = 0; i < WS_LIVE_MAX_CLIENTS; i++) if (liveClientRequests[i] == id) liveClientRequests[i] = 0;
+}
+
+static bool addLiveClient(uint32_t id)
+{
+  LiveClient *lc = findLiveClient(id);
+  if (lc) { lc->stop = false; return true; }
+  size_t used = 0;
+  int freeRequest = -1;
+  for (size_t i = 0; i < WS_LIVE_MAX_CLIENTS; i++) {
+    if (liveClientRequests[i] == id) return true;
+    if (liveClients[i].id) used++;
+    if (liveClientRequests[i]) used++;
+    else if (freeRequest < 0) freeRequest = i;
+  }
+  if (used >= WS_LIVE_MAX_CLIENTS || freeRequest < 0) return false;
+  liveClientRequests[freeRequest] = id;
+  return true;
+}
+
+static void handleLiveAck(uint32_t id, uint8_t seq)
+{
+  LiveClient *lc = findLiveClient(id);
+  if (!lc) return;
+  lc->ackSeq = seq;
+  lc->acked = true;
+}
+
+// loop: acknowledged frame is the new base
+static void applyLiveAck(LiveClient *lc)
+{
+  lc->acked = false;
+  if (!lc->inFlight || lc->ackSeq != lc->seq) return;
+  uint8_t *tmp = lc->base; lc->base = lc->sent; lc->sent = tmp;
+  lc->baseSeq = lc->seq;
+  lc->hasBase = true;
+  lc->inFlight = false;
+  if (lc->interval > WS_LIVE_INTERVAL) lc->interval = max(lc->interval - 4, WS_LIVE_INTERVAL); // recover slowly
+}
+
+// LEDs per frame, all clients together stay within WS_LIVE_TOTAL_LEDS
+static size_t getLiveClientMaxLeds()
+{
+  size_t clients = 0;
+  for (size_t i = 0; i < WS_LIVE_MAX_CLIENTS; i++) if (liveClients[i].id) clients++;
+  return min(MAX_LIVE_LEDS_WS_DELTA, WS_LIVE_TOTAL_LEDS / max(clients, (size_t)1));
+}
+
+// size of delta (dst == nullptr) or encode it
+static size_t encodeLiveDelta(uint8_t *dst, const uint8_t *base, const uint8_t *cur, size_t count)
+{
+  size_t pos = 0;
+  for (size_t i = 0; i < count; ) {
+    size_t run = 0;
+    while (i + run < count && run < 128 && !memcmp(base + (i+run)*3, cur + (i+run)*3, 3)) run++;
+    if (run) {
+      if (dst) dst[pos] = 0x80 | (run-1);
+      pos++;
+      i += run;
+      continue;
+    }
+    while (i + run < count && run < 128 && memcmp(base + (i+run)*3, cur + (i+run)*3, 3)) run++;
+    if (dst) {
+      dst[pos] = run-1;
+      for (size_t j = 0; j < run*3; j++) dst[pos+1+j] = base[i*3+j] ^ cur[i*3+j];
+    }
+    pos += 1 + run*3;
+    i += run;
+  }
+  return pos;
+}
+
+static void sendLiveFrame(LiveClient *lc, AsyncWebSocketClient *wsc)
+{
+  LiveSampling ls = getLiveSampling(getLiveClientMaxLeds());
+  if (!ls.count) return;
+  if (lc->count != ls.count || !lc->frames) {
+    free(lc->frames);
+    #if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM) && defined(WLED_USE_PSRAM)
+    if (psramFound())
+      lc->frames = (uint8_t*)ps_malloc(ls.count * 6);
+    else
+    #endif
+      lc->frames = (uint8_t*)malloc(ls.count * 6);
+    lc->base = lc->frames;
+    lc->sent = lc->frames ? lc->frames + ls.count*3 : nullptr;
+    lc->count = lc->frames ? ls.count : 0;
+    lc->hasBase = false;
+    if (!lc->frames) return;
+  }
+  writeLiveLeds(lc->sent, ls);
+
+  size_t keyLen = ls.count*3;
+  size_t deltaLen = lc->hasBase ? encodeLiveDelta(nullptr, lc->base, lc->sent, ls.count) : keyLen;
+  bool isDelta = deltaLen < keyLen;
+  AsyncWebSocketMessageBuffer * wsBuf = ws.makeBuffer(WS_LIVE_HEADER + (isDelta ? deltaLen : keyLen));
+  if (!wsBuf) return; //out of memory, retry next interval
+  uint8_t* buffer = wsBuf->get();
+  lc->seq++;
+  buffer[0]  = 'L';
+  buffer[1]  = 3; //version
+  buffer[2]  = isDelta ? WS_LIVE_DELTA : WS_LIVE_KEYFRAME;
+  buffer[3]  = lc->seq;
+  buffer[4]  = lc->baseSeq;
+  buffer[5]  = ls.count >> 8;
+  buffer[6]  = ls.count & 0xFF;
+  buffer[7]  = ls.width >> 8;
+  buffer[8]  = ls.width & 0xFF;
+  buffer[9]  = ls.height >> 8;
+  buffer[10] = ls.height & 0xFF;
+  if (isDelta) encodeLiveDelta(buffer + WS_LIVE_HEADER, lc->base, lc->sent, ls.count);
+  else         memcpy(buffer + WS_LIVE_HEADER, lc->sent, keyLen);
+  lc->inFlight = true; // before sending, ack may arrive any time after
+  wsc->binary(wsBuf);
+}
+
+static void handleLiveClients()
+{
+  unsigned long now = millis();
+  for (size_t i = 0; i < WS_LIVE_MAX_CLIENTS; i++) {
+    uint32_t id = liveClientRequests[i];
+    if (!id) continue;
+    LiveClient *lc = findLiveClient(id) ? nullptr : findLiveClient(0);
+    if (lc) {
+      lc->interval = WS_LIVE_INTERVAL;
+      lc->id = id;
+    }
+    liveClientRequests[i] = 0;
+  }
+  for (size_t i = 0; i < WS_LIVE_MAX_CLIENTS; i++) {
+    LiveClient *lc = &liveClients[i];
+    if (!lc->id) continue;
+    AsyncWebSocketClient *wsc = ws.client(lc->id);
+    if (!wsc || lc->stop) { removeLiveClient(lc->id); continue; }
+    if (lc->acked) applyLiveAck(lc);
+    if (lc->inFlight) {
+      if (now - lc->lastSent < WS_LIVE_ACK_TIMEOUT) continue;
+      lc->inFlight = false; // lost, client state unknown
+      lc->hasBase = false;
+      lc->interval = min(lc->interval * 2, WS_LIVE_MAX_INTERVAL);
+    }
+    if (now - lc->lastSent < lc->interval) continue;
+    lc->lastSent = now;
+    if (wsc->queueLength() > 0) { // link can not keep up, back off
+      lc->interval = min(lc->interval * 3 / 2, WS_LIVE_MAX_INTERVAL);
+      continue;
+    }
+    sendLiveFrame(lc, wsc);
+  }
+}
+
 void handleWs()
 {
   if (millis() - wsLastLiveTime > WS_LIVE_INTERVAL)
@@ -226,6 +878,9 @@ void handleWs()
     wsLastLiveTime = millis();
     if (!success) wsLastLiveTime -= 20; //try again in 20ms if failed due to non-empty WS queue
   }
+  // periodic snapshot repairs lost state patches even if state does not change
+  if (millis() - wsLastSnapshot >= WS_SNAPSHOT_INTERVAL && countWsDiffClients()) sendDataWs();
+  handleLiveClients();
 }
 
 #else
@@ -0,0 +1,116 @@
+#ifndef WLED_WS_REASSEMBLY_H
+#define WLED_WS_REASSEMBLY_H
+
+/*
+ * WebSocket message reassembly
+ *
+ * The async WebSocket server hands data over as it arrives: a message may consist of several frames
+ * (the first carrying the message opcode, then continuation frames) and each frame may be split into
+ * several chunks. Chunks are collected per client into a buffer growing frame by frame up to a limit.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef WS_REASSEMBLY_SLOTS
+  #ifdef ESP8266
+    #define WS_REASSEMBLY_SLOTS 1
+  #else
+    #define WS_REASSEMBLY_SLOTS 2
+  #endif
+#endif
+
+#define WS_FRAGMENT_PENDING  0 // message not complete yet (or being discarded)
+#define WS_FRAGMENT_COMPLETE 1 // message returned, call release() when done with it
+#define WS_FRAGMENT_ERROR    2 // too large, out of order, out of memory or no free slot, rest of the message is discarded
+
+class WsReassembly {
+  public:
+    WsReassembly() { memset(_slots, 0, sizeof(_slots)); }
+
+    // chunk of frame frameNum (0 = first frame of the message) at index within the frame of frameLen bytes
+    // on WS_FRAGMENT_COMPLETE msg/msgLen hold the message (null terminated) and its opcode
+    uint8_t feed(uint32_t client, uint8_t opcode, uint32_t frameNum, bool final, uint64_t index, uint64_t frameLen,
+                 const uint8_t *data, size_t len, size_t limit, uint8_t **msg, size_t *msgLen, uint8_t *msgOpcode) {
+      bool last = final && index + len >= frameLen;
+      Slot *s = find(client);
+      if (frameNum == 0 && index == 0) {
+        if (s) release(s); // previous message was never finished
+        else s = find(0);  // free slot
+        if (!s) return WS_FRAGMENT_ERROR; // later chunks are ignored as there is no slot for them
+        s->client = client;
+        s->opcode = opcode;
+      } else if (!s) {
+        return WS_FRAGMENT_PENDING; // message was not started here (no slot) or already failed
+      }
+      if (s->discard) {
+        if (last) release(s);
+        return WS_FRAGMENT_PENDING;
+      }
+      if (frameNum != s->frame || index != s->frameIndex || index + len > frameLen || s->len + len > limit) return fail(s, last);
+
+      if (s->len + len > s->cap) {
+        size_t cap = s->len + (size_t)(frameLen - index); // room for the rest of this frame
+        if (cap > limit) cap = limit;
+        uint8_t *buf = (uint8_t*)realloc(s->buf, cap + 1);
+        if (!buf) return fail(s, last);
+        s->buf = buf;
+        s->cap = cap;
+      }
+      if (len) memcpy(s->buf + s->len, data, len);
+      s->len += len;
+      s->frameIndex = index + len;
+      if (s->frameIndex >= frameLen) { s->frame++; s->frameIndex = 0; }
+      if (!last) return WS_FRAGMENT_PENDING;
+
+      if (!s->buf) s->buf = (uint8_t*)malloc(1); // empty message
+      if (!s->buf) return fail(s, last);
+      s->buf[s->len] = 0;
+      *msg = s->buf;
+      *msgLen = s->len;
+      *msgOpcode = s->opcode;
+      return WS_FRAGMENT_COMPLETE;
+    }
+
+    // frees message of client (after WS_FRAGMENT_COMPLETE or on disconnect)
+    void release(uint32_t client) {
+      Slot *s = find(client);
+      if (s) release(s);
+    }
+
+  private:
+    struct Slot {
+      uint8_t *buf;
+      size_t   len;
+      size_t   cap;
+      uint64_t frameIndex; // expected index of next chunk within the frame
+      uint32_t client;     // 0 = free
+      uint32_t frame;      // expected frame number
+      uint8_t  opcode;
+      bool     discard;
+    };
+
+    Slot* find(uint32_t client) {
+      for (size_t i = 0; i < WS_REASSEMBLY_SLOTS; i++) if (_slots[i].client == client) return &_slots[i];
+      return nullptr;
+    }
+
+    uint8_t fail(Slot *s, bool last) {
+      free(s->buf);
+      s->buf = nullptr;
+      s->len = s->cap = 0;
+      s->discard = true;
+      if (last) release(s);
+      return WS_FRAGMENT_ERROR;
+    }
+
+    void release(Slot *s) {
+      free(s->buf);
+      memset(s, 0, sizeof(Slot));
+    }
+
+    Slot _slots[WS_REASSEMBLY_SLOTS];
+};
+
+#endif
@@ -225,8 +225,16 @@ void appendGPIOinfo() {
   oappend(SET_F(";"));
 }
 
+SettingsLiveValues getSettingsLiveValues()
+{
+  SettingsLiveValues live;
+  live.milliamps = strip.currentMilliamps;
+  live.hueError  = hueError;
+  return live;
+}
+
 //get values for settings form in javascript
-void getSettingsJS(byte subPage, char* dest)
+void getSettingsJS(byte subPage, char* dest, const SettingsLiveValues &live)
 {
   //0: menu 1: wifi 2: leds 3: ui 4: sync 5: time 6: sec
   DEBUG_PRINT(F("settings resp"));
@@ -411,11 +419,11 @@ void getSettingsJS(byte subPage, char* dest)
     }
     sappend('v',SET_F("MA"),strip.ablMilliampsMax);
     sappend('v',SET_F("LA"),strip.milliampsPerLed);
-    if (strip.currentMilliamps)
+    if (live.milliamps)
     {
       sappends('m',SET_F("(\"pow\")[0]"),(char*)"");
       olen -= 2; //delete ";
-      oappendi(strip.currentMilliamps);
+      oappendi(live.milliamps);
       oappend(SET_F("mA\";"));
     }
 
@@ -550,7 +558,7 @@ void getSettingsJS(byte subPage, char* dest)
     sappend('c',SET_F("HB"),hueApplyBri);
     sappend('c',SET_F("HC"),hueApplyColor);
     char hueErrorString[25];
-    switch (hueError)
+    switch (live.hueError)
     {
       case HUE_ERROR_INACTIVE     : strcpy_P(hueErrorString,PSTR("Inactive"));                break;
       case HUE_ERROR_ACTIVE       : strcpy_P(hueErrorString,PSTR("Active"));                  break;
@@ -559,7 +567,7 @@ void getSettingsJS(byte subPage, char* dest)
       case HUE_ERROR_PUSHLINK     : strcpy_P(hueErrorString,PSTR("Link button not pressed")); break;
       case HUE_ERROR_JSON_PARSING : strcpy_P(hueErrorString,PSTR("JSON parsing error"));      break;
       case HUE_ERROR_TIMEOUT      : strcpy_P(hueErrorString,PSTR("Timeout"));                 break;
-      default: sprintf_P(hueErrorString,PSTR("Bridge Error %i"),hueError);
+      default: sprintf_P(hueErrorString,PSTR("Bridge Error %i"),live.hueError);
     }
 
     sappends('m',SET_F("(\"sip\")[0]"),hueErrorString);